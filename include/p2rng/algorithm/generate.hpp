@@ -22,6 +22,8 @@
 #ifndef _P2RNG_ALGORITHM_GENERATE_HPP_
 #define _P2RNG_ALGORITHM_GENERATE_HPP_
 
+#include <p2rng/traits.hpp>
+
 /**
  * === oneAPI ==================================================================
  */
@@ -222,48 +224,462 @@ namespace p2rng
 #else
 
 #   include <omp.h>
+#   include <algorithm>
+#   include <array>
+#   include <iterator>
+#   include <memory>
+#   include <atomic>
+#   include <chrono>
+#   include <mutex>
+#   include <cstdint>
+#   include <p2rng/pcg/pcg_random.hpp>
+#   include <p2rng/execution.hpp>
+#   include <p2rng/executor.hpp>
+#   include <p2rng/memory.hpp>
 namespace p2rng {
 
+namespace detail {
+
+// writes the next n random numbers of g to out, in bulk if g supports it
+template <typename Generator, typename OutputIt>
+inline void generate_block(Generator& g, OutputIt out, std::size_t n)
+{   if constexpr (has_fill_v<Generator, OutputIt>)
+        g.fill(out, n);
+    else
+        for (std::size_t i{0}; i < n; ++i)
+            out[i] = g();
+}
+
+// same as generate_block() but the cache line aligned bulk of the output is
+// staged through a small buffer and written with streaming stores
+template <typename Generator, typename T>
+inline void generate_block_streaming(Generator& g, T* out, std::size_t n)
+{   constexpr std::size_t chunk{4096 / sizeof(T)};
+    alignas(cache_line_size) T buf[chunk];
+
+    auto head{cache_line_offset(out, n)};
+    generate_block(g, out, head);
+    out += head;
+    n   -= head;
+    while (n >= chunk)
+    {   generate_block(g, buf, chunk);
+        stream_copy(buf, chunk, out);
+        out += chunk;
+        n   -= chunk;
+    }
+    auto body{n - n % (cache_line_size / sizeof(T))};
+    generate_block(g, buf, body);
+    stream_copy(buf, body, out);
+    generate_block(g, out + body, n - body);
+    stream_fence();
+}
+
+// {f(0), f(1), ..., f(N - 1)}
+template <typename F, std::size_t... k>
+inline auto make_array(F& f, std::index_sequence<k...>)
+->  std::array<decltype(f(std::size_t(0))), sizeof...(k)>
+{   return {{f(k)...}};   }
+
+// writes the runs tidx, tidx + size, tidx + 2 * size, ... of the n random
+// numbers of g to out. A run is R consecutive elements, except for the
+// first one, which is head elements long if head > 0. Each position in a
+// run is drawn by its own leapfrog engine. If the leapfrog engines have a
+// bulk fill(), each one fills its share of a batch of runs with it, so a
+// batch kernel of a distribution (e.g. the vectorized inverse normal CDF)
+// yields the same values as in the block partition.
+template <std::size_t R, typename Generator, typename OutputIt>
+inline void generate_leapfrog
+(   const Generator& g
+,   OutputIt out
+,   std::size_t n
+,   std::size_t head
+,   std::size_t tidx
+,   std::size_t size
+,   [[maybe_unused]] bool streaming
+)
+{   // in virtual indices, element i + off, all runs are R long
+    const std::size_t off = head ? R - head : 0;
+    const std::size_t stride = size * R;
+
+    auto make_lane = [&](std::size_t k)
+    {   std::size_t v = tidx * R + k;
+        if (v < off)
+            v += stride;
+        auto tlg = g;
+        tlg.discard(v - off);
+        return tlg.leapfrog(stride);
+    };
+    auto lane = make_array(make_lane, std::make_index_sequence<R>{});
+
+    typedef typename std::iterator_traits<OutputIt>::value_type T;
+    typedef typename decltype(lane)::value_type Lane;
+    if constexpr (std::is_arithmetic_v<T> && has_fill_v<Lane, T*>)
+    {   constexpr std::size_t C{64};   // runs per batch
+        T buf[R][C];
+        for (std::size_t v = tidx * R; v < n + off; v += C * stride)
+        {   // lane k draws the runs [lo, hi) of the batch, all but the first
+            // run of the output and those past its end
+            for (std::size_t k = 0; k < R; ++k)
+            {   std::size_t lo = v + k < off ? 1 : 0;
+                std::size_t hi = v + k < n + off
+                ?   std::min(C, (n + off - v - k - 1) / stride + 1)
+                :   0;
+                if (hi > lo)
+                    lane[k].fill(buf[k] + lo, hi - lo);
+            }
+            for (std::size_t j = 0; j < C && v + j * stride < n + off; ++j)
+            {   std::size_t w = v + j * stride;
+                if (w < off || w - off + R > n)
+                {   for (std::size_t k = 0; k < R; ++k)
+                        if (w + k >= off && w + k - off < n)
+                            out[w + k - off] = buf[k][j];
+                    continue;
+                }
+                if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+                {   if (streaming)
+                    {   alignas(cache_line_size) T run[R];
+                        for (std::size_t k = 0; k < R; ++k)
+                            run[k] = buf[k][j];
+                        stream_copy(run, R, std::addressof(*out) + (w - off));
+                        continue;
+                    }
+                }
+                for (std::size_t k = 0; k < R; ++k)
+                    out[w - off + k] = buf[k][j];
+            }
+        }
+        if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+            if (streaming)
+                stream_fence();
+        return;
+    }
+
+    for (std::size_t v = tidx * R; v < n + off; v += stride)
+    {   if (v < off || v - off + R > n)
+        {   // a partial run at either end
+            for (std::size_t k = 0; k < R; ++k)
+                if (v + k >= off && v + k - off < n)
+                    out[v + k - off] = lane[k]();
+            continue;
+        }
+        if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+        {   if (streaming)
+            {   // a full run is an aligned cache line
+                alignas(cache_line_size) T buf[R];
+                for (std::size_t k = 0; k < R; ++k)
+                    buf[k] = lane[k]();
+                stream_copy(buf, R, std::addressof(*out) + (v - off));
+                continue;
+            }
+        }
+        for (std::size_t k = 0; k < R; ++k)
+            out[v - off + k] = lane[k]();
+    }
+    if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+        if (streaming)
+            stream_fence();
+}
+
 /**
- *  @brief Assigns @a n random numbers in parallel, generated by given function
- *  object @a g.
+ *  @brief Number of cheap random numbers (see @a cost_class) a thread must
+ *  generate to be worth its share of starting and joining a team.
+ *
+ *  Calibrated once, on the first use outside of an active parallel region:
+ *  the time of an empty parallel region over all threads against that of
+ *  drawing numbers from a PCG engine, times four, so the fork/join overhead
+ *  is at most about a fifth of the total. Inside an active region (e.g. with
+ *  an orphaned executor) the regions timed would be nested ones, so until
+ *  then it returns a typical value, @a 2^16, without caching it.
+ */
+inline std::size_t calibrated_grain()
+{   static std::atomic<std::size_t> grain{0};
+    if (auto g = grain.load(std::memory_order_acquire))
+        return g;
+    if (omp_in_parallel())
+        return std::size_t(1) << 16;
+
+    static std::mutex m;
+    std::lock_guard<std::mutex> lock(m);
+    if (auto g = grain.load(std::memory_order_relaxed))
+        return g;
+    grain.store([]
+    {   using clock = std::chrono::steady_clock;
+        auto ns = [](clock::duration d)
+        {   return std::chrono::duration<double, std::nano>(d).count();   };
+
+        // best of a few rounds, to filter out interruptions
+        double fork{1e300}, sample{1e300};
+        constexpr int rounds{5}, regions{16};
+        constexpr std::size_t samples{4096};
+        pcg32 g(42u);
+        std::unique_ptr<std::uint32_t[]> buf(new std::uint32_t[samples]);
+        for (int r = 0; r < rounds; ++r)
+        {   auto t0 = clock::now();
+            for (int i = 0; i < regions; ++i)
+            {
+                #pragma omp parallel
+                {   volatile int sink{0};
+                    (void)sink;
+                }
+            }
+            auto t1 = clock::now();
+            g.fill(buf.get(), samples);
+            auto t2 = clock::now();
+            fork   = std::min(fork, ns(t1 - t0) / regions);
+            sample = std::min(sample, ns(t2 - t1) / samples);
+        }
+        sample = std::max(sample, 0.1);
+        return std::clamp
+        (   std::size_t(4 * fork / sample)
+        ,   std::size_t(1) << 10
+        ,   std::size_t(1) << 20
+        );
+    }()
+    ,   std::memory_order_release
+    );
+    return grain.load(std::memory_order_relaxed);
+}
+
+// relative cost of one sample per cost_class
+inline constexpr std::size_t cost_weight(cost_class c)
+{   return cost_class::cheap == c ? 1 : cost_class::moderate == c ? 4 : 16;   }
+
+// number of threads worth using for n samples of cost class c, at most size
+inline std::size_t team_size
+(   std::size_t n
+,   cost_class c
+,   std::size_t size
+,   std::size_t grain
+)
+{   if (0 == grain)
+        grain = calibrated_grain();
+    std::size_t team = n * cost_weight(c) / grain;
+    return std::clamp(team, std::size_t(1), std::max(size, std::size_t(1)));
+}
+
+} // end detail namespace
+
+/**
+ *  @brief Assigns @a n random numbers in parallel on the threads of executor
+ *  @a ex, generated by given function object @a g.
  *
  *  The random numbers are assigned to the first @a n elements in the range
  *  beginning at \a out, if \a n > 0. Does nothing otherwise. @a g must be
  *  either a random number engine or a bind object formed from a distribution
  *  and an engine returned by \a p2rng::bind(). Lambdas are not supported.
+ *  If @a g provides a bulk @a fill() member (e.g. PCG engines), each thread
+ *  uses it to produce its block instead of calling @a g one value at a time.
+ *  Output to contiguous memory is written with streaming stores if the
+ *  @a policy asks for it (see @a p2rng::execution::store). The work is split
+ *  into one block per thread, or into dynamically scheduled chunks (see
+ *  @a p2rng::execution::schedule), or dealt out to the threads by leapfrog
+ *  engines (see @a p2rng::execution::partition); the random numbers are the
+ *  same either way, and for every kind of executor. With an
+ *  @a executor::kind::orphaned executor, all threads of the enclosing
+ *  parallel region must make the call.
+ *  Small outputs use fewer threads, down to the calling one alone, depending
+ *  on @a n and the @a cost_class of @a g (see @a execution::policy::grain).
  *  @ingroup mutating_algorithms
  *  @tparam OutputIt iterator type for @a out
  *  @tparam Size type for @a n
  *  @tparam Generator generator type for @a g
+ *  @param  ex  executor providing the threads
  *  @param  out the beginning of the range of random numbers to generate
  *  @param  n   number of random numbers to generate
  *  @param  g   generator function object. Only a random number engine or a bind
  *              object returned by \a p2rng::bind() are valid.
+ *  @param  policy optional execution policy
  *  @return Iterator one past the last random number if @a n > 0, @a out
  *          otherwise.
  */
 template <typename OutputIt, typename Size, typename Generator>
 inline OutputIt generate_n
-(   OutputIt out
+(   executor& ex
+,   OutputIt out
 ,   Size n
 ,   Generator g
+,   const execution::policy& policy = {}
 )
-{
-    #pragma omp parallel
-    {   auto tidx{omp_get_thread_num()};
-        auto size{omp_get_num_threads()};
-        Size first{tidx * n / size};
-        Size last{(tidx + 1) * n / size};
-        auto tlg = g;   // make a thread local copy
-        tlg.discard(first);
-        for (auto i{first}; i < last; ++i)
-            out[i] = tlg();
+{   [[maybe_unused]] bool streaming{false};
+    if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+    {   typedef typename std::iterator_traits<OutputIt>::value_type T;
+        streaming = n > 0
+        &&  (   policy.store == execution::store::streaming
+            ||  (   policy.store == execution::store::automatic
+                &&  std::size_t(n) * sizeof(T) >= policy.streaming_threshold
+                )
+            );
+    }
+
+    // writes [first, last) with tlg, which is positioned at first
+    auto write = [&](Generator& tlg, Size first, Size last)
+    {   if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+        {   if (streaming)
+            {   detail::generate_block_streaming
+                (   tlg
+                ,   std::addressof(*out) + first
+                ,   last - first
+                );
+                return;
+            }
+        }
+        detail::generate_block(tlg, out + first, last - first);
+    };
+
+    // as many threads as n samples are worth, but all of an orphaned team for
+    // the worksharing loops below, which every thread of it must reach
+    std::size_t team = n > 0
+    ?   detail::team_size
+        (   std::size_t(n)
+        ,   sample_cost_v<Generator>
+        ,   ex.size()
+        ,   policy.grain
+        )
+    :   1;
+    if  (   executor::kind::orphaned == ex.get_kind()
+        &&  policy.schedule != execution::schedule::static_blocks
+        )
+        team = ex.size();
+
+    if constexpr (has_leapfrog_v<Generator>)
+    {   if (policy.partition == execution::partition::leapfrog && n > 0)
+        {   // runs of one cache line, aligned to the cache lines of the output
+            constexpr std::size_t R = is_contiguous_arithmetic_v<OutputIt>
+            ?   std::max<std::size_t>
+                (   1
+                ,   cache_line_size
+                /   sizeof(typename std::iterator_traits<OutputIt>::value_type)
+                )
+            :   1;
+            std::size_t head{0};
+            if constexpr (is_contiguous_arithmetic_v<OutputIt>)
+                head = cache_line_offset(std::addressof(*out), std::size_t(n));
+            ex.run
+            (   [&](std::size_t tidx, std::size_t size)
+                {   detail::generate_leapfrog<R>
+                    (   g
+                    ,   out
+                    ,   std::size_t(n)
+                    ,   head
+                    ,   tidx
+                    ,   size
+                    ,   streaming
+                    );
+                }
+            ,   team
+            );
+            std::advance(out, n);
+            return out;
+        }
+    }
+
+    if (policy.schedule == execution::schedule::static_blocks)
+    {   ex.run
+        (   [&](std::size_t tidx, std::size_t size)
+            {   Size first{Size(tidx * n / size)};
+                Size last{Size((tidx + 1) * n / size)};
+                auto tlg = g;   // make a thread local copy
+                tlg.discard(first);
+                write(tlg, first, last);
+            }
+        ,   team
+        );
+    }
+    else
+    {   // about 16 chunks per thread, but not too small to amortize discard()
+        Size chunk = policy.chunk_size
+        ?   Size(policy.chunk_size)
+        :   std::max(Size(4096), Size(n / Size(16 * team)));
+        Size chunks = n > 0 ? (n - 1) / chunk + 1 : 0;
+        bool guided{policy.schedule == execution::schedule::guided};
+        std::atomic<Size> cursor{0};   // next unassigned element (thread pool)
+
+        ex.run
+        (   [&](std::size_t, std::size_t size)
+            {   auto tlg = g;   // make a thread local copy
+                Size pos{0};    // position of tlg in the sequence
+                // chunks are handed out in increasing order, so tlg only ever
+                // needs to skip forward to the start of the next one
+                auto next = [&](Size first, Size last)
+                {   tlg.discard(first - pos);
+                    write(tlg, first, last);
+                    pos = last;
+                };
+
+                if (!ex.uses_openmp())
+                {   // guided: half the remaining work per thread at a time
+                    Size first{cursor.load(std::memory_order_relaxed)}, last;
+                    for (;;)
+                    {   do
+                        {   if (first >= n)
+                                return;
+                            Size c = guided
+                            ?   std::max(chunk, Size((n - first) / (2 * size)))
+                            :   chunk;
+                            last = n - first > c ? first + c : n;
+                        }
+                        while
+                        (   !cursor.compare_exchange_weak
+                            (   first
+                            ,   last
+                            ,   std::memory_order_relaxed
+                            )
+                        );
+                        next(first, last);
+                        first = cursor.load(std::memory_order_relaxed);
+                    }
+                }
+                else if (guided)
+                {
+                    #pragma omp for schedule(guided)
+                    for (Size c = 0; c < chunks; ++c)
+                        next(c * chunk, std::min(c * chunk + chunk, n));
+                }
+                else
+                {
+                    #pragma omp for schedule(dynamic)
+                    for (Size c = 0; c < chunks; ++c)
+                        next(c * chunk, std::min(c * chunk + chunk, n));
+                }
+            }
+        ,   team
+        );
     }
     std::advance(out, n);
     return out;
 }
 
+/**
+ *  @brief Assigns @a n random numbers in parallel, generated by given function
+ *  object @a g.
+ *
+ *  Same as @a generate_n() on an @a executor::kind::openmp executor, i.e.
+ *  each call runs in its own OpenMP parallel region. Use an executor with a
+ *  thread pool, or an orphaned one inside an enclosing parallel region, to
+ *  avoid starting a team on every call.
+ *  @ingroup mutating_algorithms
+ *  @tparam OutputIt iterator type for @a out
+ *  @tparam Size type for @a n
+ *  @tparam Generator generator type for @a g
+ *  @param  out the beginning of the range of random numbers to generate
+ *  @param  n   number of random numbers to generate
+ *  @param  g   generator function object. Only a random number engine or a bind
+ *              object returned by \a p2rng::bind() are valid.
+ *  @param  policy optional execution policy
+ *  @return Iterator one past the last random number if @a n > 0, @a out
+ *          otherwise.
+ */
+template <typename OutputIt, typename Size, typename Generator>
+inline OutputIt generate_n
+(   OutputIt out
+,   Size n
+,   Generator g
+,   const execution::policy& policy = {}
+)
+{   executor ex;
+    return p2rng::generate_n(ex, out, n, g, policy);
+}
+
 /**
  *  @brief Assigns in parallel to each elements in the range @p [first,last)
  *  a random number generated by given function object @a g.
@@ -279,6 +695,7 @@ inline OutputIt generate_n
  *  @param  last  the end of the range of random numbers to generate
  *  @param  g     generator function object. Only a random number engine or a
  *                bind object returned by \a p2rng::bind() are valid.
+ *  @param  policy optional execution policy
  *  @return none
  */
 template <typename ForwardIt, typename Generator>
@@ -286,9 +703,73 @@ inline void generate
 (   ForwardIt first
 ,   ForwardIt last
 ,   Generator g
+,   const execution::policy& policy = {}
+)
+{   auto n{std::distance(first, last)};
+    p2rng::generate_n(first, n, g, policy);
+}
+
+/**
+ *  @brief Assigns in parallel on the threads of executor @a ex to each
+ *  elements in the range @p [first,last) a random number generated by given
+ *  function object @a g.
+ *
+ *  @a g must be either a random number engine or a bind object formed from a
+ *  distribution and an engine returned by \a p2rng::bind(). Lambdas are not
+ *  supported.
+ *  @ingroup mutating_algorithms
+ *  @tparam ForwardIt iterator type for @a first and @a last
+ *  @tparam Generator generator type for @a g
+ *  @param  ex    executor providing the threads
+ *  @param  first the beginning of the range of random numbers to generate
+ *  @param  last  the end of the range of random numbers to generate
+ *  @param  g     generator function object. Only a random number engine or a
+ *                bind object returned by \a p2rng::bind() are valid.
+ *  @param  policy optional execution policy
+ *  @return none
+ */
+template <typename ForwardIt, typename Generator>
+inline void generate
+(   executor& ex
+,   ForwardIt first
+,   ForwardIt last
+,   Generator g
+,   const execution::policy& policy = {}
 )
 {   auto n{std::distance(first, last)};
-    p2rng::generate_n(first, n, g);
+    p2rng::generate_n(ex, first, n, g, policy);
+}
+
+/**
+ *  @brief Allocates an array of @a n elements of type @a T and fills it in
+ *  parallel with random numbers generated by given function object @a g.
+ *
+ *  The memory is not touched before the generation, so with
+ *  @a numa::local each thread's block of the output lands on the NUMA node
+ *  the thread runs on (bind the threads, e.g. with OMP_PROC_BIND, for this to
+ *  be stable). @a numa::interleaved and @a numa::on_node() place the pages
+ *  explicitly. The values are the same as those of @a p2rng::generate_n().
+ *  @ingroup mutating_algorithms
+ *  @tparam T value type of the array
+ *  @tparam Size type for @a n
+ *  @tparam Generator generator type for @a g
+ *  @param  n      number of random numbers to generate
+ *  @param  g      generator function object. Only a random number engine or a
+ *                 bind object returned by \a p2rng::bind() are valid.
+ *  @param  where  optional NUMA placement of the array
+ *  @param  policy optional execution policy
+ *  @return @a p2rng::unique_array owning the random numbers
+ */
+template <typename T, typename Size, typename Generator>
+inline unique_array<T> make_random_array
+(   Size n
+,   Generator g
+,   numa::placement where = numa::local
+,   const execution::policy& policy = {}
+)
+{   unique_array<T> a(std::size_t(n), where);
+    p2rng::generate_n(a.begin(), n, g, policy);
+    return a;
 }
 
 } // end p2rng namespace
@@ -22,7 +22,12 @@
 #ifndef _P2RNG_BIND_HPP_
 #define _P2RNG_BIND_HPP_
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 
 namespace p2rng {
 
@@ -40,9 +45,37 @@ struct bind_struct
     auto operator() () -> typename Distribution::result_type
     {   return _d(_e);   }
 
+    // skips n samples, i.e. n times draws_per_sample_v numbers of the engine;
+    // takes whatever distance type the engine's discard() does, not all
+    // engines name it (e.g. the TRNG ones)
+    template <typename Z>
     P2RNG_DEVICE_CODE
-    void discard(typename Engine::state_type n)
-    {   _e.discard(n);  }
+    void discard(Z n)
+    {   _e.discard(n * Z(draws_per_sample_v<Distribution, Engine>));  }
+
+    // batch generation, only available if the distribution provides a
+    // generate(engine, out, n) member
+    template <typename OutputIt>
+    auto fill(OutputIt out, std::size_t n)
+    ->  decltype
+        (   std::declval<Distribution&>().generate(std::declval<Engine&>(), out, n)
+        ,   void()
+        )
+    {   _d.generate(_e, out, n);   }
+
+    // generator drawing every stride-th sample, only available if the engine
+    // has a leapfrog engine and a sample takes one number of it
+    template
+    <   typename Z
+    ,   typename E = Engine
+    ,   typename = std::enable_if_t<1 == draws_per_sample_v<Distribution, E>>
+    >
+    auto leapfrog(Z stride) const
+    ->  bind_struct
+        <   Distribution
+        ,   decltype(std::declval<const E&>().leapfrog(stride))
+        >
+    {   return {_d, _e.leapfrog(stride)};   }
 
 private:
     Distribution _d;
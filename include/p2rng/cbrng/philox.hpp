@@ -0,0 +1,341 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_CBRNG_PHILOX_HPP_
+#define _P2RNG_CBRNG_PHILOX_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <p2rng/device.hpp>
+
+namespace p2rng {
+
+namespace detail {
+
+// high and low words of the double width product a * b
+
+P2RNG_DEVICE_CODE
+inline void mulhilo
+(   std::uint32_t a
+,   std::uint32_t b
+,   std::uint32_t& hi
+,   std::uint32_t& lo
+)
+{   std::uint64_t p = std::uint64_t(a) * b;
+    hi = std::uint32_t(p >> 32);
+    lo = std::uint32_t(p);
+}
+
+P2RNG_DEVICE_CODE
+inline void mulhilo
+(   std::uint64_t a
+,   std::uint64_t b
+,   std::uint64_t& hi
+,   std::uint64_t& lo
+)
+{
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+    hi = __umul64hi(a, b);
+    lo = a * b;
+#elif defined(__SIZEOF_INT128__)
+    __uint128_t p = __uint128_t(a) * b;
+    hi = std::uint64_t(p >> 64);
+    lo = std::uint64_t(p);
+#else
+    std::uint64_t a0 = a & 0xffffffffu, a1 = a >> 32;
+    std::uint64_t b0 = b & 0xffffffffu, b1 = b >> 32;
+    std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    std::uint64_t mid = (p00 >> 32) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu);
+    hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    lo = a * b;
+#endif
+}
+
+// multipliers and Weyl key increments of Salmon et al., "Parallel random
+// numbers: as easy as 1, 2, 3", SC'11
+template <typename UIntType, std::size_t N>
+struct philox_constants;
+
+template <>
+struct philox_constants<std::uint32_t, 4>
+{   static constexpr std::uint32_t m0 = 0xD2511F53u;
+    static constexpr std::uint32_t m1 = 0xCD9E8D57u;
+    static constexpr std::uint32_t w0 = 0x9E3779B9u;
+    static constexpr std::uint32_t w1 = 0xBB67AE85u;
+};
+
+template <>
+struct philox_constants<std::uint64_t, 2>
+{   static constexpr std::uint64_t m0 = 0xD2B74407B1CE6E93u;
+    static constexpr std::uint64_t w0 = 0x9E3779B97F4A7C15u;
+};
+
+} // end detail namespace
+
+/**
+ *  @brief Philox counter-based random number engine.
+ *
+ *  Each block of @a N outputs is a keyed bijection (@a R rounds of multiply
+ *  and xor) of its index, so the engine keeps no recurrence state: the key
+ *  comes from the seed, the low 64 bits of the counter are the block index
+ *  and the remaining counter words select one of 2^(N*w-64) independent
+ *  streams. @a discard() simply moves the counter and costs one block,
+ *  whatever the distance, which makes any position in the sequence as cheap
+ *  to reach as the next one.
+ *
+ *  The outputs of the bijection match the Random123 known-answer tests.
+ *  @tparam UIntType word type, @a std::uint32_t or @a std::uint64_t
+ *  @tparam N number of words per block, 4 for 32-bit and 2 for 64-bit words
+ *  @tparam R number of rounds
+ */
+template <typename UIntType, std::size_t N, std::size_t R>
+class philox_engine
+{   static_assert
+    (   (std::is_same_v<UIntType, std::uint32_t> && 4 == N)
+    ||  (std::is_same_v<UIntType, std::uint64_t> && 2 == N)
+    ,   "only Philox4x32 and Philox2x64 are supported"
+    );
+
+    typedef detail::philox_constants<UIntType, N> constants;
+
+public:
+    typedef UIntType      result_type;
+    typedef std::uint64_t state_type;
+
+    static constexpr std::size_t word_size  = sizeof(UIntType) * 8;
+    static constexpr std::size_t word_count = N;
+    static constexpr std::size_t key_count  = N / 2;
+    static constexpr std::size_t round_count = R;
+    static constexpr std::uint64_t default_seed = 20111115u;
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type min()
+    {   return 0;   }
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type max()
+    {   return ~result_type(0);   }
+
+    /**
+     *  @brief Creates an engine positioned at the beginning of stream
+     *  @a stream of the sequence keyed by @a seed.
+     */
+    P2RNG_DEVICE_CODE
+    explicit philox_engine
+    (   std::uint64_t seed = default_seed
+    ,   std::uint64_t stream = 0
+    )
+    {   this->seed(seed, stream);   }
+
+    P2RNG_DEVICE_CODE
+    void seed(std::uint64_t s = default_seed, std::uint64_t stream = 0)
+    {   if constexpr (4 == N)
+        {   _key[0]    = result_type(s);
+            _key[1]    = result_type(s >> 32);
+            _stream[0] = result_type(stream);
+            _stream[1] = result_type(stream >> 32);
+        }
+        else
+        {   _key[0]    = result_type(s);
+            _stream[0] = result_type(stream);
+        }
+        _block = 0;
+        refill();
+        _i = 0;
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator() ()
+    {   if (N == _i)
+        {   ++_block;
+            refill();
+            _i = 0;
+        }
+        return _out[_i++];
+    }
+
+    /// advances the engine by @a z steps in constant time
+    P2RNG_DEVICE_CODE
+    void discard(state_type z)
+    {   state_type blocks = z / N;
+        std::size_t i = _i + std::size_t(z % N);   // in [0, 2N)
+        if (i > N)
+        {   ++blocks;
+            i -= N;
+        }
+        if (blocks)
+        {   _block += blocks;
+            refill();
+        }
+        _i = i;
+    }
+
+    /**
+     *  @brief Writes the next @a n outputs to @a out, same as @a n calls to
+     *  @a operator() but with the blocks computed several at a time.
+     */
+    template <typename OutputIt>
+    void fill(OutputIt out, std::size_t n)
+    {   constexpr std::size_t lanes = 2;
+        std::size_t k = 0;
+        for (; k < n && _i < N; ++k)
+            out[k] = _out[_i++];
+
+        // whole blocks straight to the output, two independent blocks at a
+        // time keep both multipliers busy
+        while (n - k >= lanes * N)
+        {   result_type x[N][lanes];
+            for (std::size_t l = 0; l < lanes; ++l)
+                counter(_block + 1 + l, x, l);
+            rounds<lanes>(x);
+            for (std::size_t l = 0; l < lanes; ++l)
+                for (std::size_t j = 0; j < N; ++j)
+                    out[k + l * N + j] = x[j][l];
+            _block += lanes;
+            for (std::size_t j = 0; j < N; ++j)
+                _out[j] = x[j][lanes - 1];
+            k += lanes * N;
+        }
+        for (; k < n; ++k)
+            out[k] = operator()();
+    }
+
+    /**
+     *  @brief The Philox bijection: @a out = Philox_key(@a ctr) with
+     *  @a key_count key words and @a word_count counter words.
+     */
+    P2RNG_DEVICE_CODE
+    static void bijection
+    (   const result_type* ctr
+    ,   const result_type* key
+    ,   result_type* out
+    )
+    {   result_type x[N][1], k[N / 2];
+        for (std::size_t j = 0; j < N; ++j)
+            x[j][0] = ctr[j];
+        for (std::size_t j = 0; j < N / 2; ++j)
+            k[j] = key[j];
+        rounds<1>(x, k);
+        for (std::size_t j = 0; j < N; ++j)
+            out[j] = x[j][0];
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator== (const philox_engine& lhs, const philox_engine& rhs)
+    {   for (std::size_t j = 0; j < N / 2; ++j)
+            if (lhs._key[j] != rhs._key[j] || lhs._stream[j] != rhs._stream[j])
+                return false;
+        // the position just past a block is the same as the start of the next
+        auto pos = [](const philox_engine& e)
+        {   return e._block * N + e._i;   };
+        return pos(lhs) == pos(rhs);
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator!= (const philox_engine& lhs, const philox_engine& rhs)
+    {   return !(lhs == rhs);   }
+
+private:
+    // lane l of x gets the counter of block b
+    template <std::size_t L>
+    P2RNG_DEVICE_CODE
+    void counter(std::uint64_t b, result_type (&x)[N][L], std::size_t l) const
+    {   if constexpr (4 == N)
+        {   x[0][l] = result_type(b);
+            x[1][l] = result_type(b >> 32);
+            x[2][l] = _stream[0];
+            x[3][l] = _stream[1];
+        }
+        else
+        {   x[0][l] = result_type(b);
+            x[1][l] = _stream[0];
+        }
+    }
+
+    template <std::size_t L>
+    P2RNG_DEVICE_CODE
+    void rounds(result_type (&x)[N][L]) const
+    {   result_type k[N / 2];
+        for (std::size_t j = 0; j < N / 2; ++j)
+            k[j] = _key[j];
+        rounds<L>(x, k);
+    }
+
+    // R rounds on L counters at once, the key is bumped in between
+    template <std::size_t L>
+    P2RNG_DEVICE_CODE
+    static void rounds(result_type (&x)[N][L], result_type (&k)[N / 2])
+    {   for (std::size_t r = 0; r < R; ++r)
+        {   if (r > 0)
+            {   k[0] += constants::w0;
+                if constexpr (4 == N)
+                    k[1] += constants::w1;
+            }
+            // the keys in locals, or the stores to x could alias them
+            const result_type k0 = k[0], k1 = k[N / 2 - 1];
+            for (std::size_t l = 0; l < L; ++l)
+            {   if constexpr (4 == N)
+                {   result_type hi0, lo0, hi1, lo1;
+                    detail::mulhilo(constants::m0, x[0][l], hi0, lo0);
+                    detail::mulhilo(constants::m1, x[2][l], hi1, lo1);
+                    x[0][l] = hi1 ^ x[1][l] ^ k0;
+                    x[1][l] = lo1;
+                    x[2][l] = hi0 ^ x[3][l] ^ k1;
+                    x[3][l] = lo0;
+                }
+                else
+                {   result_type hi, lo;
+                    detail::mulhilo(constants::m0, x[0][l], hi, lo);
+                    x[0][l] = hi ^ k0 ^ x[1][l];
+                    x[1][l] = lo;
+                }
+            }
+        }
+    }
+
+    // computes the outputs of the current block
+    P2RNG_DEVICE_CODE
+    void refill()
+    {   result_type x[N][1];
+        counter(_block, x, 0);
+        rounds<1>(x);
+        for (std::size_t j = 0; j < N; ++j)
+            _out[j] = x[j][0];
+    }
+
+    result_type   _key[N / 2];
+    result_type   _stream[N / 2];   // counter words above the block index
+    std::uint64_t _block;           // block index, low 64 bits of the counter
+    result_type   _out[N];          // outputs of block _block
+    std::size_t   _i;               // next output in _out, N if used up
+};
+
+/// Philox4x32-10: four 32-bit outputs per block, 2^64 streams
+typedef philox_engine<std::uint32_t, 4, 10> philox4x32;
+
+/// Philox2x64-10: two 64-bit outputs per block, 2^64 streams
+typedef philox_engine<std::uint64_t, 2, 10> philox2x64;
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_CBRNG_PHILOX_HPP_
@@ -0,0 +1,335 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_CBRNG_THREEFRY_HPP_
+#define _P2RNG_CBRNG_THREEFRY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <p2rng/device.hpp>
+
+namespace p2rng {
+
+namespace detail {
+
+// rotation amounts of Salmon et al., "Parallel random numbers: as easy as
+// 1, 2, 3", SC'11, for word j of round r
+
+template <std::size_t N>
+struct threefry_rotations;
+
+template <>
+struct threefry_rotations<4>
+{   P2RNG_DEVICE_CODE
+    static constexpr unsigned get(std::size_t r, std::size_t j)
+    {   switch (r % 8)
+        {   case 0:  return j ? 16 : 14;
+            case 1:  return j ? 57 : 52;
+            case 2:  return j ? 40 : 23;
+            case 3:  return j ? 37 :  5;
+            case 4:  return j ? 33 : 25;
+            case 5:  return j ? 12 : 46;
+            case 6:  return j ? 22 : 58;
+            default: return 32;
+        }
+    }
+};
+
+template <>
+struct threefry_rotations<2>
+{   P2RNG_DEVICE_CODE
+    static constexpr unsigned get(std::size_t r, std::size_t)
+    {   switch (r % 8)
+        {   case 0:  return 16;
+            case 1:  return 42;
+            case 2:  return 12;
+            case 3:  return 31;
+            case 4:  return 16;
+            case 5:  return 32;
+            case 6:  return 24;
+            default: return 21;
+        }
+    }
+};
+
+P2RNG_DEVICE_CODE
+inline std::uint64_t rotl64(std::uint64_t x, unsigned r)
+{   return (x << r) | (x >> (64 - r));   }
+
+} // end detail namespace
+
+/**
+ *  @brief Threefry counter-based random number engine.
+ *
+ *  Each block of @a N 64-bit outputs is a keyed bijection of its index
+ *  built only from additions, rotations and xors (@a R rounds, the key
+ *  injected every four), so it needs no wide multiplier. As with
+ *  @a philox_engine, the key comes from the seed, the first counter word is
+ *  the block index and the second one selects one of 2^64 streams;
+ *  @a discard() moves the counter and costs one block whatever the distance.
+ *
+ *  @a fill() runs the rounds on several consecutive counters at once, which
+ *  the compiler turns into SIMD adds, shifts and xors.
+ *
+ *  The outputs of the bijection match the Random123 known-answer tests.
+ *  @tparam N number of 64-bit words per block, 4 or 2
+ *  @tparam R number of rounds
+ */
+template <std::size_t N, std::size_t R>
+class threefry_engine
+{   static_assert(4 == N || 2 == N, "only Threefry4x64 and Threefry2x64 are supported");
+
+    typedef detail::threefry_rotations<N> rotations;
+
+    // parity word of the key schedule, from Skein
+    static constexpr std::uint64_t parity = 0x1BD11BDAA9FC1A22u;
+
+public:
+    typedef std::uint64_t result_type;
+    typedef std::uint64_t state_type;
+
+    static constexpr std::size_t word_size  = 64;
+    static constexpr std::size_t word_count = N;
+    static constexpr std::size_t key_count  = N;
+    static constexpr std::size_t round_count = R;
+    static constexpr std::uint64_t default_seed = 20111115u;
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type min()
+    {   return 0;   }
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type max()
+    {   return ~result_type(0);   }
+
+    /**
+     *  @brief Creates an engine positioned at the beginning of stream
+     *  @a stream of the sequence keyed by @a seed.
+     */
+    P2RNG_DEVICE_CODE
+    explicit threefry_engine
+    (   std::uint64_t seed = default_seed
+    ,   std::uint64_t stream = 0
+    )
+    {   this->seed(seed, stream);   }
+
+    P2RNG_DEVICE_CODE
+    void seed(std::uint64_t s = default_seed, std::uint64_t stream = 0)
+    {   result_type key[N]{};
+        key[0] = s;
+        schedule(key, _ks);
+        _stream = stream;
+        _block = 0;
+        refill();
+        _i = 0;
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator() ()
+    {   if (N == _i)
+        {   ++_block;
+            refill();
+            _i = 0;
+        }
+        return _out[_i++];
+    }
+
+    /// advances the engine by @a z steps in constant time
+    P2RNG_DEVICE_CODE
+    void discard(state_type z)
+    {   state_type blocks = z / N;
+        std::size_t i = _i + std::size_t(z % N);   // in [0, 2N)
+        if (i > N)
+        {   ++blocks;
+            i -= N;
+        }
+        if (blocks)
+        {   _block += blocks;
+            refill();
+        }
+        _i = i;
+    }
+
+    /**
+     *  @brief Writes the next @a n outputs to @a out, same as @a n calls to
+     *  @a operator() but with the blocks computed several at a time.
+     */
+    template <typename OutputIt>
+    void fill(OutputIt out, std::size_t n)
+    {   constexpr std::size_t lanes = 8;
+        std::size_t k = 0;
+        for (; k < n && _i < N; ++k)
+            out[k] = _out[_i++];
+
+        // whole blocks, lanes of them at a time, straight to the output
+        while (n - k >= lanes * N)
+        {   result_type x[N][lanes];
+            for (std::size_t l = 0; l < lanes; ++l)
+                counter(_block + 1 + l, x, l);
+            rounds<lanes>(x, _ks);
+            for (std::size_t l = 0; l < lanes; ++l)
+                for (std::size_t j = 0; j < N; ++j)
+                    out[k + l * N + j] = x[j][l];
+            _block += lanes;
+            for (std::size_t j = 0; j < N; ++j)
+                _out[j] = x[j][lanes - 1];
+            k += lanes * N;
+        }
+        for (; k < n; ++k)
+            out[k] = operator()();
+    }
+
+    /**
+     *  @brief The Threefry bijection: @a out = Threefry_key(@a ctr) with
+     *  @a key_count key words and @a word_count counter words.
+     */
+    P2RNG_DEVICE_CODE
+    static void bijection
+    (   const result_type* ctr
+    ,   const result_type* key
+    ,   result_type* out
+    )
+    {   result_type x[N][1], ks[N + 1];
+        for (std::size_t j = 0; j < N; ++j)
+            x[j][0] = ctr[j];
+        schedule(key, ks);
+        rounds<1>(x, ks);
+        for (std::size_t j = 0; j < N; ++j)
+            out[j] = x[j][0];
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator==
+    (   const threefry_engine& lhs
+    ,   const threefry_engine& rhs
+    )
+    {   for (std::size_t j = 0; j < N + 1; ++j)
+            if (lhs._ks[j] != rhs._ks[j])
+                return false;
+        // the position just past a block is the same as the start of the next
+        auto pos = [](const threefry_engine& e)
+        {   return e._block * N + e._i;   };
+        return lhs._stream == rhs._stream && pos(lhs) == pos(rhs);
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator!=
+    (   const threefry_engine& lhs
+    ,   const threefry_engine& rhs
+    )
+    {   return !(lhs == rhs);   }
+
+private:
+    // the key words followed by their parity
+    P2RNG_DEVICE_CODE
+    static void schedule(const result_type* key, result_type* ks)
+    {   ks[N] = parity;
+        for (std::size_t j = 0; j < N; ++j)
+        {   ks[j] = key[j];
+            ks[N] ^= key[j];
+        }
+    }
+
+    // lane l of x gets the counter of block b
+    template <std::size_t L>
+    P2RNG_DEVICE_CODE
+    void counter(std::uint64_t b, result_type (&x)[N][L], std::size_t l) const
+    {   x[0][l] = b;
+        x[1][l] = _stream;
+        for (std::size_t j = 2; j < N; ++j)
+            x[j][l] = 0;
+    }
+
+    // R rounds on L counters at once, key injections every fourth round
+    template <std::size_t L>
+    P2RNG_DEVICE_CODE
+    static void rounds(result_type (&x)[N][L], const result_type (&ks)[N + 1])
+    {   for (std::size_t j = 0; j < N; ++j)
+            for (std::size_t l = 0; l < L; ++l)
+                x[j][l] += ks[j];
+        rounds(x, ks, std::make_index_sequence<R>{});
+    }
+
+    // unrolled, so the rotation amounts and word pairs are constants
+    template <std::size_t L, std::size_t... r>
+    P2RNG_DEVICE_CODE
+    static void rounds
+    (   result_type (&x)[N][L]
+    ,   const result_type (&ks)[N + 1]
+    ,   std::index_sequence<r...>
+    )
+    {   (round<r>(x, ks), ...);   }
+
+    template <std::size_t r, std::size_t L>
+    P2RNG_DEVICE_CODE
+    static void round(result_type (&x)[N][L], const result_type (&ks)[N + 1])
+    {   constexpr unsigned r0 = rotations::get(r, 0);
+        constexpr unsigned r1 = rotations::get(r, 1);
+        // the words paired with 0 and 2 alternate between rounds
+        constexpr std::size_t a = r % 2 ? N - 1 : 1;
+        constexpr std::size_t b = r % 2 ? 1 : N - 1;
+        for (std::size_t l = 0; l < L; ++l)
+        {   x[0][l] += x[a][l];
+            x[a][l] = detail::rotl64(x[a][l], r0) ^ x[0][l];
+            if constexpr (4 == N)
+            {   x[2][l] += x[b][l];
+                x[b][l] = detail::rotl64(x[b][l], r1) ^ x[2][l];
+            }
+        }
+        if constexpr (3 == r % 4)
+        {   constexpr std::size_t s = (r + 1) / 4;
+            for (std::size_t j = 0; j < N; ++j)
+            {   const result_type k = ks[(s + j) % (N + 1)]
+                +   (N - 1 == j ? result_type(s) : 0);
+                for (std::size_t l = 0; l < L; ++l)
+                    x[j][l] += k;
+            }
+        }
+    }
+
+    // computes the outputs of the current block
+    P2RNG_DEVICE_CODE
+    void refill()
+    {   result_type x[N][1];
+        counter(_block, x, 0);
+        rounds<1>(x, _ks);
+        for (std::size_t j = 0; j < N; ++j)
+            _out[j] = x[j][0];
+    }
+
+    result_type   _ks[N + 1];       // key schedule
+    result_type   _stream;          // second counter word
+    std::uint64_t _block;           // block index, first counter word
+    result_type   _out[N];          // outputs of block _block
+    std::size_t   _i;               // next output in _out, N if used up
+};
+
+/// Threefry4x64-20: four 64-bit outputs per block, 2^64 streams
+typedef threefry_engine<4, 20> threefry4x64;
+
+/// Threefry2x64-20: two 64-bit outputs per block, 2^64 streams
+typedef threefry_engine<2, 20> threefry2x64;
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_CBRNG_THREEFRY_HPP_
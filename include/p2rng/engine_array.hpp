@@ -0,0 +1,366 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_ENGINE_ARRAY_HPP_
+#define _P2RNG_ENGINE_ARRAY_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include <p2rng/executor.hpp>
+#include <p2rng/memory.hpp>
+#include <p2rng/pcg/pcg_random.hpp>
+
+namespace p2rng {
+
+/**
+ *  @brief Array of many independent engines of type @a Engine, e.g. one per
+ *  agent of an agent-based model, stored as structure of arrays.
+ *
+ *  Only PCG engines (@a pcg_detail::engine) are supported. The LCG states
+ *  of all engines are one column and, for engines with selectable streams
+ *  such as @a pcg32, their increments are another; the multiplier is the
+ *  same for all. Stepping every engine once (@a step_all()) or advancing all
+ *  of them (@a discard_all()) is then a streaming loop over the columns that
+ *  the compiler vectorizes across engines, instead of a gather of scattered
+ *  engine objects. Single engines are reached through @a operator[].
+ *
+ *  The batched operations split the array into one contiguous block per
+ *  thread of an executor, the same blocks as the initialization, so the
+ *  columns of each block stay on the NUMA node of the thread that works on
+ *  them. Results do not depend on the number of threads.
+ */
+template <typename Engine>
+class engine_array;
+
+template
+<   typename xtype
+,   typename itype
+,   typename output_mixin
+,   bool output_previous
+,   typename stream_mixin
+,   typename multiplier_mixin
+>
+class engine_array
+<   pcg_detail::engine
+    <   xtype
+    ,   itype
+    ,   output_mixin
+    ,   output_previous
+    ,   stream_mixin
+    ,   multiplier_mixin
+    >
+>
+:   private output_mixin
+{   static_assert
+    (   !std::is_same_v<stream_mixin, pcg_detail::unique_stream<itype>>
+    ,   "engines whose stream is their address can't be stored column-wise"
+    );
+    // std::is_arithmetic_v is false for __uint128_t in strict ISO mode
+    static_assert
+    (   std::is_trivial_v<itype>
+    ,   "the state of the engine must be of trivial type"
+    );
+
+public:
+    typedef pcg_detail::engine
+    <   xtype
+    ,   itype
+    ,   output_mixin
+    ,   output_previous
+    ,   stream_mixin
+    ,   multiplier_mixin
+    > engine_type;
+    typedef xtype       result_type;
+    typedef itype       state_type;
+    typedef std::size_t size_type;
+
+    /// true if each engine has its own stream (increment column)
+    static constexpr bool has_streams = stream_mixin::can_specify_stream;
+
+    /**
+     *  @brief Proxy for engine @a i of an array, which steps the engine in
+     *  place and converts to, and is assigned from, @a engine_type.
+     */
+    class reference
+    {
+    public:
+        typedef xtype result_type;
+
+        static constexpr result_type min()
+        {   return engine_type::min();   }
+        static constexpr result_type max()
+        {   return engine_type::max();   }
+
+        result_type operator() ()
+        {   return _a->step(_i);   }
+
+        void discard(state_type n)
+        {   engine_type e = _a->get(_i);
+            e.discard(n);
+            _a->set(_i, e);
+        }
+
+        operator engine_type () const
+        {   return _a->get(_i);   }
+
+        reference& operator= (const engine_type& e)
+        {   _a->set(_i, e);
+            return *this;
+        }
+
+        reference(const reference&) = default;
+
+        reference& operator= (const reference& r)
+        {   _a->set(_i, engine_type(r));
+            return *this;
+        }
+
+    private:
+        friend class engine_array;
+
+        reference(engine_array* a, size_type i)
+        :   _a(a)
+        ,   _i(i)
+        {}
+
+        engine_array* _a;
+        size_type     _i;
+    };
+
+    engine_array() = default;
+
+    /**
+     *  @brief Creates @a n engines from @a seed in parallel on the threads
+     *  of executor @a ex.
+     *
+     *  Engine @a i is @a engine_type(seed, i), i.e. stream @a i, if the
+     *  engines have selectable streams. Otherwise all engines share the one
+     *  sequence of @a engine_type(seed) and engine @a i starts
+     *  @a i * 2^(period_pow2() / 2) steps into it.
+     */
+    engine_array
+    (   executor& ex
+    ,   size_type n
+    ,   state_type seed
+    ,   numa::placement where = numa::local
+    )
+    :   _state(n, where)
+    ,   _inc(has_streams ? n : 0, where)
+    {   init(ex, seed);   }
+
+    /// same as above, with a default executor
+    engine_array
+    (   size_type n
+    ,   state_type seed = state_type(0xcafef00dd15ea5e5ULL)
+    ,   numa::placement where = numa::local
+    )
+    :   _state(n, where)
+    ,   _inc(has_streams ? n : 0, where)
+    {   executor ex;
+        init(ex, seed);
+    }
+
+    size_type size() const noexcept
+    {   return _state.size();   }
+
+    bool empty() const noexcept
+    {   return _state.empty();   }
+
+    /// the column of LCG states
+    const state_type* states() const noexcept
+    {   return _state.data();   }
+
+    /// the column of increments, @a nullptr if the engines have no streams
+    const state_type* increments() const noexcept
+    {   return _inc.data();   }
+
+    reference operator[] (size_type i) noexcept
+    {   return reference(this, i);   }
+
+    engine_type operator[] (size_type i) const
+    {   return get(i);   }
+
+    /// a copy of engine @a i
+    engine_type get(size_type i) const
+    {   engine_type e;
+        if constexpr (has_streams)
+            e.set_stream(_inc[i] >> 1);
+        e.set_state(_state[i]);
+        return e;
+    }
+
+    /// replaces engine @a i by @a e
+    void set(size_type i, const engine_type& e)
+    {   if constexpr (has_streams)
+            _inc[i] = (engine_type(e).stream() << 1) | state_type(1U);
+        _state[i] = e.state();
+    }
+
+    /**
+     *  @brief Steps every engine once, in parallel on the threads of executor
+     *  @a ex, and writes the output of engine @a i to @a out[i].
+     *  @return Iterator one past the last output.
+     */
+    template <typename RandomIt>
+    RandomIt step_all(executor& ex, RandomIt out)
+    {   for_blocks
+        (   ex
+        ,   [&](size_type first, size_type last)
+            {   step_block(first, last, out + first);   }
+        );
+        return out + size();
+    }
+
+    /// same as above, with a default executor
+    template <typename RandomIt>
+    RandomIt step_all(RandomIt out)
+    {   executor ex;
+        return step_all(ex, out);
+    }
+
+    /**
+     *  @brief Advances every engine by @a n steps, in parallel on the threads
+     *  of executor @a ex.
+     *
+     *  @a n steps of an LCG are one affine map, which is worked out once and
+     *  applied to all the states: a multiply-add per engine whatever @a n.
+     */
+    void discard_all(executor& ex, state_type n)
+    {   state_type mult = 1U;
+        state_type plus = 0U;   // for an increment of one
+        {   state_type cur_mult = multiplier_mixin::multiplier();
+            state_type cur_plus = 1U;
+            for (state_type delta = n; delta > 0; delta >>= 1)
+            {   if (delta & 1U)
+                {   mult *= cur_mult;
+                    plus = plus * cur_mult + cur_plus;
+                }
+                cur_plus *= cur_mult + 1U;
+                cur_mult *= cur_mult;
+            }
+        }
+        for_blocks
+        (   ex
+        ,   [&](size_type first, size_type last)
+            {   state_type* s = _state.data();
+                if constexpr (has_streams)
+                {   const state_type* c = _inc.data();
+                    for (size_type i = first; i < last; ++i)
+                        s[i] = s[i] * mult + plus * c[i];
+                }
+                else
+                {   const state_type p = plus * stream_mixin::increment();
+                    for (size_type i = first; i < last; ++i)
+                        s[i] = s[i] * mult + p;
+                }
+            }
+        );
+    }
+
+    /// same as above, with a default executor
+    void discard_all(state_type n)
+    {   executor ex;
+        discard_all(ex, n);
+    }
+
+private:
+    // engines without streams start this many steps (as a power of two)
+    // apart in the shared sequence
+    static constexpr std::size_t spacing_pow2 = engine_type::period_pow2() / 2;
+
+    // calls f(first, last) for the block of each thread of ex
+    template <typename F>
+    void for_blocks(executor& ex, F f)
+    {   size_type n = size();
+        ex.run
+        (   [&](std::size_t tidx, std::size_t team)
+            {   f(tidx * n / team, (tidx + 1) * n / team);   }
+        );
+    }
+
+    void init(executor& ex, state_type seed)
+    {   for_blocks
+        (   ex
+        ,   [&](size_type first, size_type last)
+            {   for (size_type i = first; i < last; ++i)
+                {   if constexpr (has_streams)
+                        set(i, engine_type(seed, state_type(i)));
+                    else
+                    {   engine_type e(seed);
+                        e.advance(state_type(i) << spacing_pow2);
+                        set(i, e);
+                    }
+                }
+            }
+        );
+    }
+
+    // the same as operator() of engine i, on the columns
+    result_type step(size_type i)
+    {   state_type old_state = _state[i];
+        state_type new_state = old_state * multiplier_mixin::multiplier()
+        +   increment(i);
+        _state[i] = new_state;
+        return this->output(output_previous ? old_state : new_state);
+    }
+
+    state_type increment(size_type i) const
+    {   if constexpr (has_streams)
+            return _inc[i];
+        else
+            return stream_mixin::increment();
+    }
+
+    template <typename RandomIt>
+    void step_block(size_type first, size_type last, RandomIt out)
+    {   const state_type mult = multiplier_mixin::multiplier();
+        state_type* s = _state.data();
+        if constexpr (has_streams)
+        {   const state_type* c = _inc.data();
+            for (size_type i = first; i < last; ++i)
+            {   state_type old_state = s[i];
+                s[i] = old_state * mult + c[i];
+                out[i - first] = this->output
+                (   output_previous ? old_state : s[i]
+                );
+            }
+        }
+        else
+        {   const state_type c = stream_mixin::increment();
+            for (size_type i = first; i < last; ++i)
+            {   state_type old_state = s[i];
+                s[i] = old_state * mult + c;
+                out[i - first] = this->output
+                (   output_previous ? old_state : s[i]
+                );
+            }
+        }
+    }
+
+    unique_array<state_type> _state;
+    unique_array<state_type> _inc;
+};
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_ENGINE_ARRAY_HPP_
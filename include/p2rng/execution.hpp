@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_EXECUTION_HPP_
+#define _P2RNG_EXECUTION_HPP_
+
+#include <cstddef>
+
+namespace p2rng::execution {
+
+/**
+ *  @brief How the parallel algorithms write their output.
+ *
+ *  @a temporal writes through the cache as usual. @a streaming uses
+ *  non-temporal stores for the aligned bulk of each thread's block, which
+ *  avoids the read-for-ownership of every cache line and leaves the cache to
+ *  other data, but the output is not in the cache afterwards. @a automatic
+ *  streams only if the output is larger than @a policy::streaming_threshold.
+ */
+enum class store
+{   automatic
+,   temporal
+,   streaming
+};
+
+/**
+ *  @brief How the parallel algorithms distribute the work among threads.
+ *
+ *  @a static_blocks gives each thread one contiguous block of the output.
+ *  @a dynamic and @a guided cut the output into chunks that are handed out
+ *  to the threads as they become idle (same as the OpenMP schedules of the
+ *  same names), which balances generators with varying per-sample cost.
+ *  Each chunk starts with a @a discard() to its first element, so the output
+ *  is identical for all schedules.
+ */
+enum class schedule
+{   static_blocks
+,   dynamic
+,   guided
+};
+
+/**
+ *  @brief How the parallel algorithms split the sequence of random numbers
+ *  among the threads.
+ *
+ *  With @a blocks each thread (or chunk, see @a schedule) takes a contiguous
+ *  part of the sequence and reaches its start with one @a discard(). With
+ *  @a leapfrog the output is dealt out in runs of one cache line, thread
+ *  @a t of @a P taking runs @a t, @a t + @a P, @a t + 2 @a P, ... Each
+ *  position in a run is drawn by a leapfrog engine of stride @a P times the
+ *  run length (see @a has_leapfrog), which steps through the sequence with
+ *  no further jumps. The schedule does not apply to @a leapfrog, and
+ *  generators without leapfrog engines always use @a blocks. Only the
+ *  OpenMP algorithms take a policy; the CUDA, ROCm and SYCL versions of
+ *  @a generate_n always split the sequence in blocks.
+ */
+enum class partition
+{   blocks
+,   leapfrog
+};
+
+/**
+ *  @brief Execution policy for the parallel algorithms.
+ *
+ *  The default constructed policy gives the behaviour of the algorithms
+ *  without a policy argument. None of the options changes the generated
+ *  random numbers.
+ */
+struct policy
+{   /// store mode for the output
+    execution::store store = execution::store::automatic;
+
+    /// output size in bytes from which @a store::automatic streams; should be
+    /// well beyond the size of the last level cache
+    std::size_t streaming_threshold = std::size_t(1) << 26;
+
+    /// split of the sequence among the threads
+    execution::partition partition = execution::partition::blocks;
+
+    /// work distribution among the threads
+    execution::schedule schedule = execution::schedule::static_blocks;
+
+    /// number of elements per chunk for @a schedule::dynamic and the minimum
+    /// one for @a schedule::guided; 0 picks one from the size of the output
+    /// and the number of threads
+    std::size_t chunk_size = 0;
+
+    /// minimum number of cheap random numbers (see @a p2rng::cost_class) per
+    /// thread; smaller outputs use fewer threads. 0 uses a value calibrated
+    /// once at start-up from the fork/join cost, 1 always uses all threads
+    std::size_t grain = 0;
+};
+
+} // end p2rng::execution namespace
+
+#endif  //_P2RNG_EXECUTION_HPP_
@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_EXECUTOR_HPP_
+#define _P2RNG_EXECUTOR_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+#if defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
+#include <p2rng/memory.hpp>
+
+namespace p2rng {
+
+/**
+ *  @brief Reusable execution context for the parallel algorithms on the host.
+ *
+ *  An executor runs a function on a team of threads and waits for all of them
+ *  to finish. It is created once and passed to the algorithms, which saves
+ *  setting up the team on every call when many small ranges are generated.
+ *
+ *  - @a kind::openmp runs each call in an OpenMP parallel region (the runtime
+ *    keeps its threads alive between regions). This is what the algorithms
+ *    without an executor argument do.
+ *  - @a kind::thread_pool owns a persistent team of @a std::thread workers;
+ *    the calling thread is member 0 of the team. Idle workers spin briefly
+ *    before they block, so back to back calls don't pay a wake-up.
+ *  - @a kind::orphaned starts no threads at all: it is for use inside an
+ *    enclosing @a omp @a parallel region and uses that region's team. As with
+ *    an orphaned @a omp @a for, every thread of the team must make the same
+ *    call, and the call ends with a barrier.
+ *
+ *  Each team member also gets a cache line aligned scratch buffer that is
+ *  kept between calls (see @a scratch()). The buffers are only allocated on
+ *  first use, so an executor made for a single call costs no allocation.
+ *
+ *  A thread pool executor must not be used by several threads at once.
+ */
+class executor
+{
+public:
+    /// how the team of threads is provided
+    enum class kind
+    {   openmp
+    ,   thread_pool
+    ,   orphaned
+    };
+
+    /// where the worker threads of a @a kind::thread_pool executor run
+    enum class affinity
+    {   none    ///< left to the operating system
+    ,   compact ///< worker @a i is bound to the @a i-th allowed CPU
+    };
+
+    /**
+     *  @brief Creates an executor of kind @a k.
+     *
+     *  @param k           kind of the executor
+     *  @param num_threads size of the team; 0 picks the OpenMP default for
+     *                     @a kind::openmp and the number of hardware threads
+     *                     for @a kind::thread_pool. Ignored for
+     *                     @a kind::orphaned, which uses the enclosing team.
+     *  @param a           affinity of the workers of a @a kind::thread_pool;
+     *                     OpenMP threads follow OMP_PROC_BIND/OMP_PLACES.
+     */
+    explicit executor
+    (   kind k = kind::openmp
+    ,   std::size_t num_threads = 0
+    ,   affinity a = affinity::none
+    )
+    :   _kind(k)
+    ,   _num_threads(num_threads)
+    {   _slots = std::max<std::size_t>
+        (   {   num_threads
+            ,   std::size_t(omp_get_max_threads())
+            ,   std::size_t(omp_get_num_threads())
+            }
+        );
+        if (kind::thread_pool == k)
+        {   if (0 == _num_threads)
+                _num_threads = std::thread::hardware_concurrency();
+            _num_threads = std::max<std::size_t>(1, _num_threads);
+            _slots = _num_threads;
+        }
+        if (kind::thread_pool == k)
+        {   _pool = std::make_unique<pool>();
+            if (_num_threads <= std::thread::hardware_concurrency())
+                _pool->spin = spin_count;
+            for (std::size_t i = 1; i < _num_threads; ++i)
+                _pool->workers.emplace_back(&executor::work, this, i, a);
+        }
+    }
+
+    executor(const executor&) = delete;
+    executor& operator= (const executor&) = delete;
+
+    ~executor()
+    {   if (_pool)
+        {   {   std::lock_guard<std::mutex> lock(_pool->m);
+                _pool->stop.store(true, std::memory_order_relaxed);
+                _pool->generation.fetch_add(1, std::memory_order_release);
+            }
+            _pool->start.notify_all();
+            for (auto& t : _pool->workers)
+                t.join();
+        }
+        for (auto& s : _scratch)
+            if (s.p)
+                ::operator delete(s.p, std::align_val_t(cache_line_size));
+    }
+
+    kind get_kind() const noexcept
+    {   return _kind;   }
+
+    /// true if @a run() executes within an OpenMP parallel region, where the
+    /// OpenMP worksharing constructs can be used
+    bool uses_openmp() const noexcept
+    {   return kind::thread_pool != _kind;   }
+
+    /// number of threads the next @a run() uses
+    std::size_t size() const noexcept
+    {   switch (_kind)
+        {   case kind::thread_pool:
+                return _num_threads;
+            case kind::orphaned:
+                return std::size_t(omp_get_num_threads());
+            default:
+                return _num_threads
+                ?   _num_threads
+                :   std::size_t(omp_get_max_threads());
+        }
+    }
+
+    /**
+     *  @brief Calls @a f(tidx, team) on @a team threads of the executor,
+     *  @a tidx being the thread's index in [0, team), and returns once all
+     *  calls have returned. @a f must not throw.
+     *
+     *  A @a team of 0, or larger than @a size(), uses all threads. With a
+     *  thread pool, a team of one runs @a f on the calling thread without
+     *  waking the workers. With @a kind::orphaned all threads of the
+     *  enclosing team must still make the call; only the first @a team of
+     *  them call @a f.
+     */
+    template <typename F>
+    void run(F&& f, std::size_t team = 0)
+    {   auto all = size();
+        if (0 == team || team > all)
+            team = all;
+        switch (_kind)
+        {   case kind::thread_pool:
+                run_pool(f, team);
+                break;
+            case kind::orphaned:
+                if (std::size_t(omp_get_thread_num()) < team)
+                    f(std::size_t(omp_get_thread_num()), team);
+                #pragma omp barrier
+                break;
+            default:
+                if (1 == team)
+                    f(std::size_t(0), std::size_t(1));
+                else
+                {
+                    #pragma omp parallel num_threads(int(team))
+                    f(std::size_t(omp_get_thread_num())
+                    , std::size_t(omp_get_num_threads())
+                    );
+                }
+        }
+    }
+
+    /**
+     *  @brief Scratch space of at least @a n objects of type @a T for team
+     *  member @a tidx, aligned to @a cache_line_size.
+     *
+     *  The buffer is kept and reused by later calls, it only grows. Each
+     *  thread must only ask for its own buffer. Returns @a nullptr if
+     *  @a tidx is beyond the team size known at construction.
+     */
+    template <typename T>
+    T* scratch(std::size_t tidx, std::size_t n)
+    {   static_assert(std::is_trivial_v<T>, "T must be a trivial type");
+        if (tidx >= _slots)
+            return nullptr;
+        // the first caller of the team makes the slots for all
+        std::call_once
+        (   _scratch_made
+        ,   [this] { _scratch = std::vector<scratch_slot>(_slots); }
+        );
+        auto& s = _scratch[tidx];
+        std::size_t bytes = n * sizeof(T);
+        if (bytes > s.bytes)
+        {   if (s.p)
+                ::operator delete(s.p, std::align_val_t(cache_line_size));
+            s.p = nullptr;
+            s.bytes = 0;
+            s.p = ::operator new(bytes, std::align_val_t(cache_line_size));
+            s.bytes = bytes;
+        }
+        return static_cast<T*>(s.p);
+    }
+
+private:
+    struct alignas(cache_line_size) scratch_slot
+    {   void*       p = nullptr;
+        std::size_t bytes = 0;
+    };
+
+    struct pool
+    {   std::vector<std::thread> workers;
+        std::mutex               m;
+        std::condition_variable  start;
+        std::condition_variable  done;
+        std::atomic<std::size_t> generation{0};
+        std::atomic<std::size_t> pending{0};
+        std::atomic<bool>        stop{false};
+        void (*call)(void*, std::size_t, std::size_t) = nullptr;
+        void*                    ctx = nullptr;
+        std::size_t              team = 0;
+        int                      spin = 0;
+    };
+
+    // spins before a worker blocks on, or the caller waits for, the team;
+    // none if the team oversubscribes the hardware threads, where spinning
+    // only delays the others
+    static constexpr int spin_count = 1 << 12;
+
+    template <typename F>
+    void run_pool(F& f, std::size_t team)
+    {   if (1 == team)
+        {   f(std::size_t(0), std::size_t(1));
+            return;
+        }
+        // every worker acknowledges the call, those beyond the team idle
+        _pool->call = [](void* ctx, std::size_t tidx, std::size_t size)
+        {   (*static_cast<F*>(ctx))(tidx, size);   };
+        _pool->ctx = std::addressof(f);
+        _pool->team = team;
+        _pool->pending.store(_num_threads - 1, std::memory_order_relaxed);
+        {   std::lock_guard<std::mutex> lock(_pool->m);
+            _pool->generation.fetch_add(1, std::memory_order_release);
+        }
+        _pool->start.notify_all();
+
+        f(std::size_t(0), team);
+
+        for (int i = 0; i < _pool->spin; ++i)
+        {   if (0 == _pool->pending.load(std::memory_order_acquire))
+                return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(_pool->m);
+        _pool->done.wait
+        (   lock
+        ,   [this]
+            {   return 0 == _pool->pending.load(std::memory_order_acquire);   }
+        );
+    }
+
+    void work(std::size_t tidx, affinity a)
+    {   if (affinity::compact == a)
+            bind_to_cpu(tidx);
+
+        std::size_t seen{0};
+        for (;;)
+        {   std::size_t g{seen};
+            for (int i = 0; i < _pool->spin && g == seen; ++i)
+            {   std::this_thread::yield();
+                g = _pool->generation.load(std::memory_order_acquire);
+            }
+            if (g == seen)
+            {   std::unique_lock<std::mutex> lock(_pool->m);
+                _pool->start.wait
+                (   lock
+                ,   [&]
+                    {   return seen != _pool->generation.load
+                        (   std::memory_order_acquire
+                        );
+                    }
+                );
+                g = _pool->generation.load(std::memory_order_acquire);
+            }
+            seen = g;
+            if (_pool->stop.load(std::memory_order_relaxed))
+                return;
+
+            if (tidx < _pool->team)
+                _pool->call(_pool->ctx, tidx, _pool->team);
+
+            if (1 == _pool->pending.fetch_sub(1, std::memory_order_acq_rel))
+            {   std::lock_guard<std::mutex> lock(_pool->m);
+                _pool->done.notify_one();
+            }
+        }
+    }
+
+    // binds the calling thread to the i-th CPU it is allowed to run on
+    static void bind_to_cpu(std::size_t i)
+    {
+#if defined(__linux__) && defined(_GNU_SOURCE)
+        cpu_set_t allowed;
+        if (0 != sched_getaffinity(0, sizeof(allowed), &allowed))
+            return;
+        std::size_t count = std::size_t(CPU_COUNT(&allowed));
+        if (0 == count)
+            return;
+        i %= count;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {   if (CPU_ISSET(cpu, &allowed) && 0 == i--)
+            {   cpu_set_t one;
+                CPU_ZERO(&one);
+                CPU_SET(cpu, &one);
+                pthread_setaffinity_np(pthread_self(), sizeof(one), &one);
+                return;
+            }
+        }
+#else
+        (void)i;
+#endif
+    }
+
+    kind                      _kind;
+    std::size_t               _num_threads;
+    std::unique_ptr<pool>     _pool;
+    std::size_t               _slots;
+    std::once_flag            _scratch_made;
+    std::vector<scratch_slot> _scratch;
+};
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_EXECUTOR_HPP_
@@ -0,0 +1,277 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_MEMORY_HPP_
+#define _P2RNG_MEMORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#   include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace p2rng {
+
+/// size of a cache line in bytes
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ *  @brief Copies @a n objects of trivially copyable type @a T from @a src to
+ *  @a dst using non-temporal (streaming) stores.
+ *
+ *  @a dst must be aligned to @a cache_line_size and @a n * sizeof(T) must be a
+ *  multiple of it; @a src needs no particular alignment. Streaming stores are
+ *  weakly ordered, call @a stream_fence() before other threads read @a dst.
+ *  Falls back to @a std::memcpy on targets without streaming stores.
+ */
+template <typename T>
+inline void stream_copy(const T* src, std::size_t n, T* dst)
+{
+#if defined(__AVX__)
+    auto s = reinterpret_cast<const __m256i*>(src);
+    auto d = reinterpret_cast<__m256i*>(dst);
+    for (std::size_t i = 0; i < n * sizeof(T) / sizeof(__m256i); ++i)
+        _mm256_stream_si256(d + i, _mm256_loadu_si256(s + i));
+#elif defined(__SSE2__) || defined(_M_X64)
+    auto s = reinterpret_cast<const __m128i*>(src);
+    auto d = reinterpret_cast<__m128i*>(dst);
+    for (std::size_t i = 0; i < n * sizeof(T) / sizeof(__m128i); ++i)
+        _mm_stream_si128(d + i, _mm_loadu_si128(s + i));
+#else
+    std::memcpy(dst, src, n * sizeof(T));
+#endif
+}
+
+/**
+ *  @brief Orders the preceding streaming stores of the calling thread before
+ *  any subsequent store.
+ */
+inline void stream_fence()
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    _mm_sfence();
+#endif
+}
+
+/**
+ *  @brief Number of leading objects of type @a T before @a p is aligned to
+ *  @a cache_line_size, at most @a n.
+ */
+template <typename T>
+inline std::size_t cache_line_offset(const T* p, std::size_t n)
+{   auto r = reinterpret_cast<std::uintptr_t>(p) % cache_line_size;
+    std::size_t head = r ? (cache_line_size - r) / sizeof(T) : 0;
+    return head < n ? head : n;
+}
+
+/**
+ * === NUMA placement ==========================================================
+ */
+
+namespace numa {
+
+enum class placement_policy
+{   local       ///< pages go to the node of the thread touching them first
+,   interleaved ///< pages are spread round-robin over all nodes
+,   node        ///< all pages go to one given node
+};
+
+/**
+ *  @brief Where the pages of an array are placed on a NUMA system.
+ *
+ *  Use one of @a numa::local, @a numa::interleaved or @a numa::on_node().
+ */
+struct placement
+{   placement_policy policy;
+    int node;
+};
+
+inline constexpr placement local{placement_policy::local, -1};
+inline constexpr placement interleaved{placement_policy::interleaved, -1};
+
+/// places all pages on NUMA node @a node
+inline constexpr placement on_node(int node)
+{   return placement{placement_policy::node, node};   }
+
+/**
+ *  @brief Applies placement @a where to the pages of [p, p + bytes), which
+ *  must be page aligned and not yet touched.
+ *
+ *  The placement is a hint: on systems without NUMA support, or if the node
+ *  does not exist, the memory simply stays under the default (first touch)
+ *  policy. Returns @a true if the placement was applied, @a false if it was
+ *  not (e.g. @a mbind failed), with @a errno telling why if it was tried.
+ */
+inline bool apply(placement where, void* p, std::size_t bytes)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    const unsigned long mpol_bind{2}, mpol_interleave{3};
+    unsigned long mask{0};
+    // as in libnuma, one more than the bits of the mask: the kernel drops
+    // the last of the maxnode bits
+    const unsigned long maxnode{8 * sizeof(mask) + 1};
+    switch (where.policy)
+    {   case placement_policy::local:
+            return true;
+        case placement_policy::interleaved:
+            mask = ~0ul;
+            return 0 == syscall
+            (   SYS_mbind, p, bytes, mpol_interleave, &mask, maxnode, 0
+            );
+        case placement_policy::node:
+            if (where.node < 0 || where.node >= int(8 * sizeof(mask)))
+                return false;
+            mask = 1ul << where.node;
+            return 0 == syscall
+            (   SYS_mbind, p, bytes, mpol_bind, &mask, maxnode, 0
+            );
+    }
+    return false;
+#else
+    (void)p;
+    (void)bytes;
+    return where.policy == placement_policy::local;
+#endif
+}
+
+} // end numa namespace
+
+/**
+ *  @brief Owning, move-only array of @a n objects of trivial type @a T (e.g.
+ *  an arithmetic type or @a pcg128_t) in freshly mapped, uninitialized
+ *  memory.
+ *
+ *  The pages are not touched on construction, so they are placed on NUMA
+ *  nodes by the placement policy given or else by whoever writes them first;
+ *  @a placed() tells which.
+ */
+template <typename T>
+class unique_array
+{   static_assert(std::is_trivial_v<T>, "T must be a trivial type");
+
+public:
+    typedef T           value_type;
+    typedef std::size_t size_type;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+
+    unique_array() = default;
+
+    explicit unique_array
+    (   size_type n
+    ,   numa::placement where = numa::local
+    )
+    :   _size(n)
+    {   if (0 == n)
+            return;
+#if defined(__linux__)
+        void* p = mmap
+        (   nullptr
+        ,   bytes()
+        ,   PROT_READ | PROT_WRITE
+        ,   MAP_PRIVATE | MAP_ANONYMOUS
+        ,   -1
+        ,   0
+        );
+        if (MAP_FAILED == p)
+            throw std::bad_alloc();
+        _placed = numa::apply(where, p, bytes());
+#else
+        _placed = where.policy == numa::placement_policy::local;
+        void* p = std::malloc(bytes());
+        if (nullptr == p)
+            throw std::bad_alloc();
+#endif
+        _data = static_cast<T*>(p);
+    }
+
+    unique_array(const unique_array&) = delete;
+    unique_array& operator= (const unique_array&) = delete;
+
+    unique_array(unique_array&& other) noexcept
+    :   _data(std::exchange(other._data, nullptr))
+    ,   _size(std::exchange(other._size, 0))
+    ,   _placed(std::exchange(other._placed, true))
+    {}
+
+    unique_array& operator= (unique_array&& other) noexcept
+    {   if (this != &other)
+        {   release();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _placed = std::exchange(other._placed, true);
+        }
+        return *this;
+    }
+
+    ~unique_array()
+    {   release();   }
+
+    T* data() noexcept { return _data; }
+    const T* data() const noexcept { return _data; }
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return 0 == _size; }
+    /// true if the placement asked for was applied (see @a numa::apply())
+    bool placed() const noexcept { return _placed; }
+
+    iterator begin() noexcept { return _data; }
+    iterator end() noexcept { return _data + _size; }
+    const_iterator begin() const noexcept { return _data; }
+    const_iterator end() const noexcept { return _data + _size; }
+
+    T& operator[] (size_type i) noexcept { return _data[i]; }
+    const T& operator[] (size_type i) const noexcept { return _data[i]; }
+
+private:
+    size_type bytes() const noexcept
+    {   return _size * sizeof(T);   }
+
+    void release() noexcept
+    {   if (nullptr == _data)
+            return;
+#if defined(__linux__)
+        munmap(_data, bytes());
+#else
+        std::free(_data);
+#endif
+        _data = nullptr;
+    }
+
+    T*        _data = nullptr;
+    size_type _size = 0;
+    bool      _placed = true;
+};
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_MEMORY_HPP_
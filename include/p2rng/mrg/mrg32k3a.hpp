@@ -0,0 +1,297 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_MRG_MRG32K3A_HPP_
+#define _P2RNG_MRG_MRG32K3A_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include <p2rng/device.hpp>
+
+namespace p2rng {
+
+namespace detail {
+
+// The two components of MRG32k3a, P. L'Ecuyer, "Good parameters and
+// implementations for combined multiple recursive random number
+// generators", Operations Research 47(1), 1999. Each keeps its last three
+// values, oldest first, and step() is the product with the companion matrix
+// A = {{0, 1, 0}, {0, 0, 1}, {-a3, a2, a1}} modulo m.
+
+struct mrg32k3a_component1
+{   static constexpr std::uint64_t m  = 4294967087u;
+    static constexpr std::uint64_t a1 = 0;
+    static constexpr std::uint64_t a2 = 1403580;
+    static constexpr std::uint64_t a3 = 810728;     // negated
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t next(const std::uint32_t (&x)[3])
+    {   return (a2 * x[1] + a3 * (m - x[0])) % m;   }
+};
+
+struct mrg32k3a_component2
+{   static constexpr std::uint64_t m  = 4294944443u;
+    static constexpr std::uint64_t a1 = 527612;
+    static constexpr std::uint64_t a2 = 0;
+    static constexpr std::uint64_t a3 = 1370589;    // negated
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t next(const std::uint32_t (&x)[3])
+    {   return (a1 * x[2] + a3 * (m - x[0])) % m;   }
+};
+
+typedef std::uint32_t mrg32k3a_matrix[3][3];
+
+template <typename C>
+P2RNG_DEVICE_CODE
+constexpr void mrg32k3a_companion(mrg32k3a_matrix& a)
+{   for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+            a[i][j] = i + 1 == j;
+    a[2][0] = std::uint32_t(C::m - C::a3);
+    a[2][1] = std::uint32_t(C::a2);
+    a[2][2] = std::uint32_t(C::a1);
+}
+
+// c = a * b mod m, c may be a or b
+template <std::uint64_t m>
+P2RNG_DEVICE_CODE
+constexpr void mrg32k3a_multiply
+(   const mrg32k3a_matrix& a
+,   const mrg32k3a_matrix& b
+,   mrg32k3a_matrix& c
+)
+{   std::uint32_t t[3][3]{};
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+        {   std::uint64_t s = 0;
+            for (std::size_t k = 0; k < 3; ++k)
+                s += std::uint64_t(a[i][k]) * b[k][j] % m;
+            t[i][j] = std::uint32_t(s % m);
+        }
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+            c[i][j] = t[i][j];
+}
+
+// x = a * x mod m
+template <std::uint64_t m>
+P2RNG_DEVICE_CODE
+constexpr void mrg32k3a_apply(const mrg32k3a_matrix& a, std::uint32_t (&x)[3])
+{   std::uint64_t y[3]{};
+    for (std::size_t i = 0; i < 3; ++i)
+    {   for (std::size_t k = 0; k < 3; ++k)
+            y[i] += std::uint64_t(a[i][k]) * x[k] % m;
+    }
+    for (std::size_t i = 0; i < 3; ++i)
+        x[i] = std::uint32_t(y[i] % m);
+}
+
+/**
+ *  Jump matrices of MRG32k3a: entry k holds A^(2^k) of both components,
+ *  which advances the engine by 2^k steps. Built at compile time by
+ *  repeated squaring; the entries 76 and 127 are the substream and stream
+ *  distances of L'Ecuyer's RngStreams.
+ */
+struct mrg32k3a_jump_table
+{   static constexpr std::size_t size = 192;
+
+    mrg32k3a_matrix a1[size];
+    mrg32k3a_matrix a2[size];
+
+    constexpr mrg32k3a_jump_table() : a1(), a2()
+    {   mrg32k3a_companion<mrg32k3a_component1>(a1[0]);
+        mrg32k3a_companion<mrg32k3a_component2>(a2[0]);
+        constexpr std::uint64_t m1 = mrg32k3a_component1::m;
+        constexpr std::uint64_t m2 = mrg32k3a_component2::m;
+        for (std::size_t k = 1; k < size; ++k)
+        {   mrg32k3a_multiply<m1>(a1[k - 1], a1[k - 1], a1[k]);
+            mrg32k3a_multiply<m2>(a2[k - 1], a2[k - 1], a2[k]);
+        }
+    }
+};
+
+inline constexpr mrg32k3a_jump_table mrg32k3a_jump_table_v{};
+
+} // end detail namespace
+
+/**
+ *  @brief L'Ecuyer's MRG32k3a combined multiple recursive generator.
+ *
+ *  Returns integers in [1, m1], m1 = 4294967087; divided by m1 + 1 they are
+ *  the uniform (0, 1) numbers of L'Ecuyer's reference implementation. The
+ *  period is about 2^191.
+ *
+ *  The sequence is split as in RngStreams: streams start 2^127 steps apart
+ *  and each is divided into substreams of 2^76 steps. The engine seeded
+ *  with @a s starts at stream @a s of the package seed, 12345 for all six
+ *  state words unless given, so the default engine is the first stream of
+ *  RngStreams and engine @a s its stream number @a s.
+ *
+ *  @a discard(n), @a jump(n) and @a long_jump(n) multiply the state with
+ *  the precomputed matrices A^(2^k) modulo m1 and m2, at most one product
+ *  per bit of @a n.
+ */
+class mrg32k3a
+{   typedef detail::mrg32k3a_component1 c1;
+    typedef detail::mrg32k3a_component2 c2;
+
+public:
+    typedef std::uint32_t result_type;
+    typedef std::uint64_t state_type;
+
+    static constexpr std::uint64_t m1 = c1::m;
+    static constexpr std::uint64_t m2 = c2::m;
+    static constexpr std::uint64_t default_seed = 0;
+    static constexpr std::uint32_t package_seed = 12345;
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type min()
+    {   return 1;   }
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type max()
+    {   return result_type(m1);   }
+
+    /// stream @a stream of the default package seed
+    P2RNG_DEVICE_CODE
+    explicit mrg32k3a(std::uint64_t stream = default_seed)
+    {   seed(stream);   }
+
+    /**
+     *  @brief Stream @a stream of the package seed @a s, the state words
+     *  of the first component followed by those of the second.
+     *
+     *  The words are reduced modulo m1 and m2; the three words of neither
+     *  component may all be zero.
+     */
+    P2RNG_DEVICE_CODE
+    explicit mrg32k3a(const std::uint32_t (&s)[6], std::uint64_t stream = 0)
+    {   seed(s, stream);   }
+
+    P2RNG_DEVICE_CODE
+    void seed(std::uint64_t stream = default_seed)
+    {   const std::uint32_t s[6]
+        {   package_seed, package_seed, package_seed
+        ,   package_seed, package_seed, package_seed
+        };
+        seed(s, stream);
+    }
+
+    P2RNG_DEVICE_CODE
+    void seed(const std::uint32_t (&s)[6], std::uint64_t stream = 0)
+    {   for (std::size_t i = 0; i < 3; ++i)
+        {   _x1[i] = std::uint32_t(s[i] % m1);
+            _x2[i] = std::uint32_t(s[i + 3] % m2);
+        }
+        long_jump(stream);
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator() ()
+    {   step();
+        const std::uint32_t p1 = _x1[2], p2 = _x2[2];
+        return result_type(p1 > p2 ? p1 - p2 : p1 + m1 - p2);
+    }
+
+    /// advances the engine by @a z steps
+    P2RNG_DEVICE_CODE
+    void discard(state_type z)
+    {   // a step is cheaper than a matrix product for the lowest bits
+        constexpr state_type direct = 15;
+        for (state_type i = z & direct; i > 0; --i)
+            step();
+        advance(z & ~direct, 0);
+    }
+
+    /// advances the engine by @a n substreams of 2^76 steps; from the start
+    /// of a substream, jump() moves to the start of the next one
+    P2RNG_DEVICE_CODE
+    void jump(std::uint64_t n = 1)
+    {   advance(n, 76);   }
+
+    /// advances the engine by @a n streams of 2^127 steps
+    P2RNG_DEVICE_CODE
+    void long_jump(std::uint64_t n = 1)
+    {   advance(n, 127);   }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator== (const mrg32k3a& lhs, const mrg32k3a& rhs)
+    {   for (std::size_t i = 0; i < 3; ++i)
+            if (lhs._x1[i] != rhs._x1[i] || lhs._x2[i] != rhs._x2[i])
+                return false;
+        return true;
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator!= (const mrg32k3a& lhs, const mrg32k3a& rhs)
+    {   return !(lhs == rhs);   }
+
+private:
+    P2RNG_DEVICE_CODE
+    void step()
+    {   const std::uint64_t p1 = c1::next(_x1);
+        const std::uint64_t p2 = c2::next(_x2);
+        _x1[0] = _x1[1]; _x1[1] = _x1[2]; _x1[2] = std::uint32_t(p1);
+        _x2[0] = _x2[1]; _x2[1] = _x2[2]; _x2[2] = std::uint32_t(p2);
+    }
+
+    // advances the engine by n * 2^shift steps
+    P2RNG_DEVICE_CODE
+    void advance(std::uint64_t n, std::size_t shift)
+    {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+        // no access to the table, square as we go
+        if (0 == n)
+            return;
+        detail::mrg32k3a_matrix a1{}, a2{};
+        detail::mrg32k3a_companion<c1>(a1);
+        detail::mrg32k3a_companion<c2>(a2);
+        for (std::size_t k = 0; k < shift; ++k)
+        {   detail::mrg32k3a_multiply<m1>(a1, a1, a1);
+            detail::mrg32k3a_multiply<m2>(a2, a2, a2);
+        }
+        for (; n; n >>= 1)
+        {   if (n & 1)
+            {   detail::mrg32k3a_apply<m1>(a1, _x1);
+                detail::mrg32k3a_apply<m2>(a2, _x2);
+            }
+            detail::mrg32k3a_multiply<m1>(a1, a1, a1);
+            detail::mrg32k3a_multiply<m2>(a2, a2, a2);
+        }
+#else
+        const auto& table = detail::mrg32k3a_jump_table_v;
+        for (std::size_t k = shift; n; ++k, n >>= 1)
+            if (n & 1)
+            {   detail::mrg32k3a_apply<m1>(table.a1[k], _x1);
+                detail::mrg32k3a_apply<m2>(table.a2[k], _x2);
+            }
+#endif
+    }
+
+    std::uint32_t _x1[3];
+    std::uint32_t _x2[3];
+};
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_MRG_MRG32K3A_HPP_
@@ -81,17 +81,31 @@
  * implementation.  Sadly, it's much slower than hand-coded assembly or
  * direct CPU support.
  *
+ * The native type is used whenever the host compiler provides it, so that
+ * the state update compiles to a couple of 64-bit multiplies (mulx with
+ * BMI2).  CUDA and HIP builds keep the class, since the same type has to be
+ * seen by the host and device compilation passes, and defining
+ * PCG_FORCE_EMULATED_128BIT_MATH selects it everywhere.  Both produce
+ * identical output; pcg128_emulated_t is always available for comparison.
+ *
  */
-#if __SIZEOF_INT128__
+#include "pcg_uint128.hpp"
+namespace pcg_extras {
+    typedef pcg_extras::uint_x4<uint32_t,uint64_t> pcg128_emulated_t;
+}
+#define PCG_EMULATED_128BIT_CONSTANT(high,low) \
+        pcg_extras::pcg128_emulated_t(high,low)
+
+#if __SIZEOF_INT128__ && !defined(PCG_FORCE_EMULATED_128BIT_MATH) \
+    && !defined(__CUDACC__) && !defined(__HIPCC__)
     namespace pcg_extras {
         typedef __uint128_t pcg128_t;
     }
     #define PCG_128BIT_CONSTANT(high,low) \
             ((pcg128_t(high) << 64) + low)
 #else
-    #include "pcg_uint128.hpp"
     namespace pcg_extras {
-        typedef pcg_extras::uint_x4<uint32_t,uint64_t> pcg128_t;
+        typedef pcg128_emulated_t pcg128_t;
     }
     #define PCG_128BIT_CONSTANT(high,low) \
             pcg128_t(high,low)
@@ -90,6 +90,7 @@
 #include <type_traits>
 #include <utility>
 #include <locale>
+#include <memory>
 #include <new>
 #include <stdexcept>
 
@@ -112,6 +113,11 @@ namespace pcg_detail {
 
 using namespace pcg_extras;
 
+// The engine I/O operators below hide the pcg_extras ones, and ADL can't find
+// them for a built-in pcg128_t, so bring them in explicitly.
+using pcg_extras::operator<<;
+using pcg_extras::operator>>;
+
 /*
  * The LCG generators need some constants to function.  This code lets you
  * look up the constant by *type*.  For example
@@ -152,6 +158,14 @@ struct default_increment {
             };
 #endif // __CUDACC__
 
+#define PCG_DEFINE_HOST_CONSTANT(type, what, kind, constant)    \
+            template <>                                         \
+            struct what ## _ ## kind<type> {                    \
+                static constexpr type kind() {                  \
+                    return constant;                            \
+                }                                               \
+            };
+
 PCG_DEFINE_CONSTANT(uint8_t,  default, multiplier, 141U)
 PCG_DEFINE_CONSTANT(uint8_t,  default, increment,  77U)
 
@@ -164,11 +178,70 @@ PCG_DEFINE_CONSTANT(uint32_t, default, increment,  2891336453U)
 PCG_DEFINE_CONSTANT(uint64_t, default, multiplier, 6364136223846793005ULL)
 PCG_DEFINE_CONSTANT(uint64_t, default, increment,  1442695040888963407ULL)
 
-// PCG_DEFINE_CONSTANT(pcg128_t, default, multiplier,
-//         PCG_128BIT_CONSTANT(2549297995355413924ULL,4865540595714422341ULL))
-// PCG_DEFINE_CONSTANT(pcg128_t, default, increment,
-//         PCG_128BIT_CONSTANT(6364136223846793005ULL,1442695040888963407ULL))
+#ifndef PCG_EMULATED_128BIT_MATH
+PCG_DEFINE_CONSTANT(pcg128_t, default, multiplier,
+        PCG_128BIT_CONSTANT(2549297995355413924ULL,4865540595714422341ULL))
+PCG_DEFINE_CONSTANT(pcg128_t, default, increment,
+        PCG_128BIT_CONSTANT(6364136223846793005ULL,1442695040888963407ULL))
+#endif
+
+// uint_x4 has no device code, so its constants are host-only
+PCG_DEFINE_HOST_CONSTANT(pcg128_emulated_t, default, multiplier,
+        PCG_EMULATED_128BIT_CONSTANT(2549297995355413924ULL,4865540595714422341ULL))
+PCG_DEFINE_HOST_CONSTANT(pcg128_emulated_t, default, increment,
+        PCG_EMULATED_128BIT_CONSTANT(6364136223846793005ULL,1442695040888963407ULL))
+
+
+/*
+ * Jump tables for advancing the LCG.  Entry k holds mult^(2^k) and the
+ * additive term of 2^k steps for a unit increment, which is
+ * 1 + mult + mult^2 + ... + mult^(2^k - 1).  The increment only scales the
+ * additive term, so one table per multiplier serves every stream, and
+ * advancing by delta costs one multiply-add per set bit of delta instead of
+ * recomputing the squarings each time.
+ *
+ * For built-in integer types the table is a constexpr variable, computed
+ * at compile time.  Class types (uint_x4) can't be used in constant
+ * expressions, so their table is built once on first use.
+ */
+
+template <typename itype, typename multiplier_mixin>
+struct jump_table {
+    static constexpr size_t size = sizeof(itype)*8;
+
+    itype mult[size];
+    itype plus[size];
+
+    constexpr jump_table() : mult(), plus()
+    {
+        // 8 and 16-bit types would be promoted to (signed) int, where the
+        // products overflow, which is not allowed in a constant expression
+        typedef typename std::conditional<(sizeof(itype) < sizeof(unsigned)),
+                                          unsigned, itype>::type mtype;
+        mtype cur_mult = multiplier_mixin::multiplier();
+        mtype cur_plus = 1u;
+        for (size_t k = 0; k < size; ++k) {
+            mult[k] = itype(cur_mult);
+            plus[k] = itype(cur_plus);
+            cur_plus = itype((cur_mult+mtype(1u))*cur_plus);
+            cur_mult = itype(cur_mult*cur_mult);
+        }
+    }
+};
+
+template <typename itype, typename multiplier_mixin>
+inline constexpr jump_table<itype, multiplier_mixin> jump_table_v{};
 
+template <typename itype, typename multiplier_mixin>
+inline const jump_table<itype, multiplier_mixin>& get_jump_table()
+{
+    if constexpr (std::is_class<itype>::value) {
+        static const jump_table<itype, multiplier_mixin> table;
+        return table;
+    } else {
+        return jump_table_v<itype, multiplier_mixin>;
+    }
+}
 
 /*
  * Each PCG generator is available in four variants, based on how it applies
@@ -349,6 +422,81 @@ protected:
 };
 
 
+/*
+ * A leapfrog engine yields every stride-th output of the engine it was made
+ * from (by engine::leapfrog()), starting with the next one.  Stepping an LCG
+ * stride times is again an affine map, with the multiplier raised to the
+ * stride, so the leapfrog engine is itself an LCG and costs the same per
+ * value as the original.  Its discard() counts in strides.
+ */
+
+template <typename xtype, typename itype, typename output_mixin>
+class leapfrog_engine : protected output_mixin {
+    itype state_;       // the state whose output is next
+    itype mult_;
+    itype plus_;
+
+public:
+    typedef xtype result_type;
+    typedef itype state_type;
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type min()
+    {
+        return result_type(0UL);
+    }
+    P2RNG_DEVICE_CODE
+    static constexpr result_type max()
+    {
+        return ~result_type(0UL);
+    }
+
+    P2RNG_DEVICE_CODE
+    leapfrog_engine(itype state, itype cur_mult, itype cur_plus, itype stride)
+        : state_(state), mult_(1u), plus_(0u)
+    {
+        power(mult_, plus_, cur_mult, cur_plus, stride);
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator()()
+    {
+        itype old_state = state_;
+        state_ = state_ * mult_ + plus_;
+        return this->output(old_state);
+    }
+
+    P2RNG_DEVICE_CODE
+    void discard(itype delta)
+    {
+        itype acc_mult = 1u;
+        itype acc_plus = 0u;
+        power(acc_mult, acc_plus, mult_, plus_, delta);
+        state_ = acc_mult * state_ + acc_plus;
+    }
+
+private:
+    // (acc_mult, acc_plus) becomes the map (cur_mult, cur_plus) applied delta
+    // times after it, as in engine::advance()
+    P2RNG_DEVICE_CODE
+    static void power(itype& acc_mult, itype& acc_plus,
+                      itype cur_mult, itype cur_plus, itype delta)
+    {
+        constexpr itype ZERO = 0u;
+        constexpr itype ONE  = 1u;
+        while (delta > ZERO) {
+           if (delta & ONE) {
+              acc_mult *= cur_mult;
+              acc_plus = acc_plus*cur_mult + cur_plus;
+           }
+           cur_plus = (cur_mult+ONE)*cur_plus;
+           cur_mult *= cur_mult;
+           delta >>= 1;
+        }
+    }
+};
+
+
 /*
  * This is where it all comes together.  This function joins together three
  * mixin classes which define
@@ -447,6 +595,12 @@ protected:
     static itype advance(itype state, itype delta,
                          itype cur_mult, itype cur_plus);
 
+    // Same as advance(state, delta, multiplier(), inc) but with the
+    // precomputed jump table.  Not available in CUDA/HIP device code, where
+    // the tables are not accessible, nor in SYCL device code, which can't
+    // have the function-local static table of class types.
+    static itype jump(itype state, itype delta, itype inc);
+
     P2RNG_DEVICE_CODE
     static itype distance(itype cur_state, itype newstate, itype cur_mult,
                           itype cur_plus, itype mask = ~itype(0U));
@@ -461,7 +615,12 @@ public:
     P2RNG_DEVICE_CODE
     void advance(itype delta)
     {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__) \
+    || defined(__SYCL_DEVICE_ONLY__)
         state_ = advance(state_, delta, this->multiplier(), this->increment());
+#else
+        state_ = jump(state_, delta, this->increment());
+#endif
     }
 
     P2RNG_DEVICE_CODE
@@ -476,6 +635,52 @@ public:
         advance(delta);
     }
 
+    /*
+     * Bulk generation.  Writes the next n outputs to out, exactly as n
+     * calls to operator() would, and leaves the generator in the same
+     * state.  Internally it runs fill_lanes interleaved copies of the LCG
+     * (lane k starts k steps ahead and each lane is stepped by the
+     * multiplier raised to the lane count), so the lanes are independent
+     * and the compiler is free to vectorize across them.
+     */
+
+    static constexpr size_t fill_lanes = sizeof(itype) <= 8 ? 16 : 8;
+
+    template <typename OutputIt>
+    P2RNG_DEVICE_CODE
+    void fill(OutputIt out, size_t n);
+
+    /*
+     * Leapfrog.  Returns an engine that yields the outputs of this one at
+     * positions 0, stride, 2*stride, ... from here, so stride of them, each
+     * made one step further on, share out this engine's sequence.
+     */
+    P2RNG_DEVICE_CODE
+    leapfrog_engine<xtype, itype, output_mixin> leapfrog(size_t stride) const
+    {
+        itype next = output_previous ? state_
+                                     : state_ * multiplier() + increment();
+        return leapfrog_engine<xtype, itype, output_mixin>(
+                   next, multiplier(), increment(), itype(stride));
+    }
+
+    /*
+     * Raw access to the LCG state, for containers that keep the states of
+     * many engines column-wise (p2rng::engine_array).  The state is the one
+     * the next output comes from if output_previous, else the one before.
+     */
+    P2RNG_DEVICE_CODE
+    itype state() const
+    {
+        return state_;
+    }
+
+    P2RNG_DEVICE_CODE
+    void set_state(itype state)
+    {
+        state_ = state;
+    }
+
     P2RNG_DEVICE_CODE
     bool wrapped()
     {
@@ -673,6 +878,80 @@ itype engine<xtype,itype,output_mixin,output_previous,stream_mixin,
     return acc_mult * state + acc_plus;
 }
 
+template <typename xtype, typename itype,
+          typename output_mixin, bool output_previous,
+          typename stream_mixin, typename multiplier_mixin>
+itype engine<xtype,itype,output_mixin,output_previous,stream_mixin,
+             multiplier_mixin>::jump(itype state, itype delta, itype inc)
+{
+    // Jumps by different powers of two commute, so the set bits of delta
+    // are dealt alternately to two accumulators, which halves the chain of
+    // dependent multiplies, and combined at the end.  The set bits are
+    // visited directly (no branch per bit), 64 bits at a time.
+    const auto& table = get_jump_table<itype, multiplier_mixin>();
+    itype acc_mult[2] = {1u, 1u};
+    itype acc_plus[2] = {0u, 0u};
+    size_t j = 0;
+    constexpr size_t words = (sizeof(itype) + 7) / 8;
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t bits = words == 1 ? uint64_t(delta)
+                                   : uint64_t(delta >> bitcount_t(64*w));
+        while (bits) {
+            const size_t k = 64*w + trailingzeros(bits);
+            bits &= bits - 1;
+            acc_mult[j] *= table.mult[k];
+            acc_plus[j] = acc_plus[j]*table.mult[k] + table.plus[k];
+            j ^= 1;
+        }
+    }
+    return acc_mult[1] * (acc_mult[0] * state + acc_plus[0] * inc)
+         + acc_plus[1] * inc;
+}
+
+template <typename xtype, typename itype,
+          typename output_mixin, bool output_previous,
+          typename stream_mixin, typename multiplier_mixin>
+template <typename OutputIt>
+P2RNG_DEVICE_CODE
+void engine<xtype,itype,output_mixin,output_previous,stream_mixin,
+            multiplier_mixin>::fill(OutputIt out, size_t n)
+{
+    constexpr size_t lanes = fill_lanes;
+    const itype cur_mult = multiplier();
+    const itype cur_plus = increment();
+
+    // The lane step is the LCG applied lanes times, i.e. the affine map
+    // s -> mult^lanes * s + plus * (mult^(lanes-1) + ... + mult + 1).
+    itype lane_mult = 1u;
+    itype lane_plus = 0u;
+    itype lane[lanes];
+    lane[0] = output_previous ? state_ : bump(state_);
+    for (size_t k = 1; k < lanes; ++k)
+        lane[k] = lane[k-1] * cur_mult + cur_plus;
+    for (size_t k = 0; k < lanes; ++k) {
+        lane_mult *= cur_mult;
+        lane_plus = lane_plus * cur_mult + cur_plus;
+    }
+
+    const size_t body = n - n % lanes;
+    for (size_t i = 0; i < body; i += lanes) {
+        for (size_t k = 0; k < lanes; ++k)
+            out[i+k] = this->output(lane[k]);
+        for (size_t k = 0; k < lanes; ++k)
+            lane[k] = lane[k] * lane_mult + lane_plus;
+    }
+
+    // Bring the scalar state up to date and do the ragged tail the slow way.
+    if (body > 0) {
+        if (output_previous)
+            state_ = lane[0];
+        else
+            advance(itype(uint64_t(body)));
+    }
+    for (size_t i = body; i < n; ++i)
+        out[i] = operator()();
+}
+
 template <typename xtype, typename itype,
           typename output_mixin, bool output_previous,
           typename stream_mixin, typename multiplier_mixin>
@@ -925,10 +1204,17 @@ PCG_DEFINE_CONSTANT(uint32_t, mcg, unmultiplier, 2897767785U)
 PCG_DEFINE_CONSTANT(uint64_t, mcg, multiplier,   12605985483714917081ULL)
 PCG_DEFINE_CONSTANT(uint64_t, mcg, unmultiplier, 15009553638781119849ULL)
 
-// PCG_DEFINE_CONSTANT(pcg128_t, mcg, multiplier,
-//         PCG_128BIT_CONSTANT(17766728186571221404ULL, 12605985483714917081ULL))
-// PCG_DEFINE_CONSTANT(pcg128_t, mcg, unmultiplier,
-//         PCG_128BIT_CONSTANT(14422606686972528997ULL, 15009553638781119849ULL))
+#ifndef PCG_EMULATED_128BIT_MATH
+PCG_DEFINE_CONSTANT(pcg128_t, mcg, multiplier,
+        PCG_128BIT_CONSTANT(17766728186571221404ULL, 12605985483714917081ULL))
+PCG_DEFINE_CONSTANT(pcg128_t, mcg, unmultiplier,
+        PCG_128BIT_CONSTANT(14422606686972528997ULL, 15009553638781119849ULL))
+#endif
+
+PCG_DEFINE_HOST_CONSTANT(pcg128_emulated_t, mcg, multiplier,
+        PCG_EMULATED_128BIT_CONSTANT(17766728186571221404ULL, 12605985483714917081ULL))
+PCG_DEFINE_HOST_CONSTANT(pcg128_emulated_t, mcg, unmultiplier,
+        PCG_EMULATED_128BIT_CONSTANT(14422606686972528997ULL, 15009553638781119849ULL))
 
 
 template <typename xtype, typename itype>
@@ -1049,7 +1335,10 @@ struct xsl_rr_mixin {
  */
 
 template <typename T> struct halfsize_trait {};
+#ifndef PCG_EMULATED_128BIT_MATH
 template <> struct halfsize_trait<pcg128_t>  { typedef uint64_t type; };
+#endif
+template <> struct halfsize_trait<pcg128_emulated_t> { typedef uint64_t type; };
 template <> struct halfsize_trait<uint64_t>  { typedef uint32_t type; };
 template <> struct halfsize_trait<uint32_t>  { typedef uint16_t type; };
 template <> struct halfsize_trait<uint16_t>  { typedef uint8_t type;  };
@@ -1181,9 +1470,52 @@ struct inside_out : private baseclass {
         randval = baseclass::output(state);
         return crosses_zero;
     }
+
+    /*
+     * The pieces shared_extended needs to step table entries on the fly,
+     * which it keeps as the states behind the values.
+     */
+
+    P2RNG_DEVICE_CODE
+    static result_type external_output(state_type state)
+    {
+        return baseclass::output(state);
+    }
+
+    P2RNG_DEVICE_CODE
+    static state_type external_state(result_type randval)
+    {
+        return baseclass::unoutput(randval);
+    }
+
+    P2RNG_DEVICE_CODE
+    static state_type external_multiplier()
+    {
+        return baseclass::multiplier();
+    }
+
+    P2RNG_DEVICE_CODE
+    static state_type external_increment(size_t i)
+    {
+        return baseclass::increment() + state_type(i*2);
+    }
+
+    // steps before the entry with the given state carries
+    P2RNG_DEVICE_CODE
+    static state_type external_distance(state_type state, size_t i)
+    {
+        state_type zero =
+            baseclass::is_mcg ? state & state_type(3U) : state_type(0U);
+        return baseclass::distance(state, zero, baseclass::multiplier(),
+                                   external_increment(i), ~state_type(0U));
+    }
 };
 
 
+template <bitcount_t table_pow2, bitcount_t advance_pow2, typename baseclass, typename extvalclass, bool kdd>
+class shared_extended;
+
+
 template <bitcount_t table_pow2, bitcount_t advance_pow2, typename baseclass, typename extvalclass, bool kdd = true>
 class extended : public baseclass {
 public:
@@ -1200,7 +1532,7 @@ private:
     static constexpr size_t table_size  = 1UL << table_pow2;
     static constexpr size_t table_shift = stypebits - table_pow2;
     static constexpr state_type table_mask =
-        (state_type(1U) << table_pow2) - state_type(1U);
+        state_type((uint64_t(1) << table_pow2) - 1U);   // constexpr for uint_x4
 
     static constexpr bool   may_tick  =
         (advance_pow2 < stypebits) && (advance_pow2 < tick_limit_pow2);
@@ -1226,8 +1558,8 @@ private:
             // The low order bits of an MCG are constant, so drop them.
             state >>= 2;
         }
-        size_t index       = kdd ? state &  table_mask
-                                 : state >> table_shift;
+        size_t index       = kdd ? size_t(state &  table_mask)
+                                 : size_t(state >> table_shift);
 
         if (may_tick) {
             bool tick = kdd ? (state & tick_mask) == state_type(0u)
@@ -1267,6 +1599,20 @@ public:
         return bounded_rand(*this, upper_bound);
     }
 
+    // The multi-lane fill of the base class would skip the extension
+    // table, so we have to fall back to one value at a time.
+    template <typename OutputIt>
+    P2RNG_DEVICE_CODE
+    void fill(OutputIt out, size_t n)
+    {
+        for (size_t i = 0; i < n; ++i)
+            out[i] = operator()();
+    }
+
+    // For the same reason, the extended generator is no LCG and has no
+    // leapfrog engine.
+    void leapfrog(size_t stride) const = delete;
+
     void set(result_type wanted)
     {
         result_type& rhs = get_extended_value();
@@ -1283,6 +1629,27 @@ public:
         advance(distance, false);
     }
 
+    // Must advance the table too, which the base class discard() doesn't.
+    P2RNG_DEVICE_CODE
+    void discard(state_type distance)
+    {
+        advance(distance);
+    }
+
+    /*
+     * The extension table as it is now, for generators that share it
+     * instead of holding a copy (see shared_extended).
+     */
+    typedef shared_extended<table_pow2, advance_pow2,
+                            baseclass, extvalclass, kdd> shared_type;
+
+    auto share() const
+    {
+        return typename shared_type::table(*this);
+    }
+
+    friend shared_type;
+
     P2RNG_DEVICE_CODE
     extended(const result_type* data)
         : baseclass()
@@ -1564,6 +1931,305 @@ void extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::advance(
     }
 }
 
+/*
+ * A shared_extended generator yields the same numbers as the extended
+ * generator it was made from, but does not hold the extension table.  The
+ * table, as it was when shared, is held once by a shared_extended::table
+ * (made by extended::share()), and the generators refer to it and keep the
+ * base state and the number of times the table has ticked since.  Copies
+ * are thus as cheap as the base generator, e.g. one per thread of a
+ * parallel algorithm, and discard() just counts the ticks it skips.
+ *
+ * An entry that has ticked t times is the shared entry stepped t times by
+ * its own LCG, and t steps of all those LCGs are one affine map (up to the
+ * increment), which is kept up to date as the ticks come.  The shared table
+ * holds the states behind the entries, so an entry costs a multiply-add
+ * and the output function.  Entries only take extra steps once an earlier
+ * one carries, which does not happen for the first horizon ticks; after
+ * that each value also checks whether the entry before it has carried, as
+ * advance_table() does.
+ */
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+class shared_extended : public baseclass {
+    static_assert(kdd,
+        "Efficient advance is too hard for non-kdd extension.");
+
+public:
+    typedef typename baseclass::state_type  state_type;
+    typedef typename baseclass::result_type result_type;
+    typedef extended<table_pow2, advance_pow2,
+                     baseclass, extvalclass, kdd> extended_type;
+    // refers to the shared table, so it is not serializable
+    // (see p2rng::holds_pointers)
+    typedef std::true_type holds_pointers;
+
+private:
+    typedef typename extended_type::insideout insideout;
+    typedef typename insideout::state_type    ext_state_t;
+
+public:
+    /*
+     * The shared table.  It must outlive the generators made from it.
+     */
+    class table {
+        baseclass   base_;
+        ext_state_t horizon_;
+        std::unique_ptr<ext_state_t[]> states_;
+
+    public:
+        explicit table(const extended_type& rng)
+            : base_(rng), horizon_(~ext_state_t(0U)),
+              states_(new ext_state_t[extended_type::table_size])
+        {
+            for (size_t i = 0; i < extended_type::table_size; ++i) {
+                states_[i] = insideout::external_state(rng.data_[i]);
+                ext_state_t d = insideout::external_distance(states_[i], i+1);
+                if (d < horizon_)
+                    horizon_ = d;
+            }
+        }
+
+        // the states behind the entries, extended_type::table_size of them
+        const ext_state_t* data() const
+        {
+            return states_.get();
+        }
+
+        ext_state_t horizon() const
+        {
+            return horizon_;
+        }
+
+        shared_extended generator() const
+        {
+            return shared_extended(base_, data(), horizon_);
+        }
+    };
+
+private:
+    const ext_state_t* table_;
+    state_type  ticks_ = 0U;    // since the table was shared
+    ext_state_t mult_  = 1U;    // ticks_ steps of an entry, for a unit
+    ext_state_t plus_  = 0U;    // increment
+    ext_state_t horizon_;       // ticks before the first carry
+
+    P2RNG_DEVICE_CODE
+    void tick(state_type delta);
+
+    P2RNG_DEVICE_CODE
+    result_type entry(size_t index) const;
+
+    P2RNG_DEVICE_CODE
+    state_type carry_out(size_t i, state_type carry) const;
+
+    P2RNG_DEVICE_CODE
+    state_type carry_into(size_t index) const;
+
+    P2RNG_DEVICE_CODE
+    result_type get_extended_value()
+    {
+        state_type state = this->state_;
+        if (kdd && baseclass::is_mcg) {
+            // The low order bits of an MCG are constant, so drop them.
+            state >>= 2;
+        }
+        size_t index = size_t(state & extended_type::table_mask);
+
+        if (extended_type::may_tick) {
+            if ((state & extended_type::tick_mask) == state_type(0u))
+                tick(1U);
+        }
+        if (extended_type::may_tock) {
+            if (state == state_type(0u))
+                tick(1U);
+        }
+        return entry(index);
+    }
+
+public:
+    static constexpr size_t period_pow2()
+    {
+        return extended_type::period_pow2();
+    }
+
+    /*
+     * From the base generator, the shared states and the horizon of a
+     * table; the states may be a copy of table::data(), e.g. in device
+     * memory.
+     */
+    P2RNG_DEVICE_CODE
+    shared_extended(const baseclass& base, const ext_state_t* states,
+                    ext_state_t horizon)
+        : baseclass(base), table_(states), horizon_(horizon)
+    {
+        // Nothing else to do.
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator()()
+    {
+        result_type rhs = get_extended_value();
+        result_type lhs = this->baseclass::operator()();
+        return lhs ^ rhs;
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator()(result_type upper_bound)
+    {
+        return bounded_rand(*this, upper_bound);
+    }
+
+    // As for extended, neither the multi-lane fill nor leapfrog of the
+    // base class apply.  Stepping a local copy keeps the state in
+    // registers, as the output can't alias it.
+    template <typename OutputIt>
+    P2RNG_DEVICE_CODE
+    void fill(OutputIt out, size_t n)
+    {
+        shared_extended rng = *this;
+        for (size_t i = 0; i < n; ++i)
+            out[i] = rng();
+        *this = rng;
+    }
+
+    void leapfrog(size_t stride) const = delete;
+
+    // The table is read only, so there is no way back.
+    void backstep(state_type distance) = delete;
+
+    P2RNG_DEVICE_CODE
+    void advance(state_type distance);
+
+    P2RNG_DEVICE_CODE
+    void discard(state_type distance)
+    {
+        advance(distance);
+    }
+};
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+P2RNG_DEVICE_CODE
+void shared_extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::tick(
+        state_type delta)
+{
+    ticks_ += delta;
+    ext_state_t cur_mult = insideout::external_multiplier();
+    ext_state_t cur_plus = 1U;
+    // the entries' LCGs have a period of 2^extbits, so truncating is fine
+    ext_state_t n = ext_state_t(delta);
+    while (n > 0U) {
+        if (n & 1U) {
+            mult_ *= cur_mult;
+            plus_ = plus_*cur_mult + cur_plus;
+        }
+        cur_plus = (cur_mult+1U)*cur_plus;
+        cur_mult *= cur_mult;
+        n >>= 1;
+    }
+}
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+P2RNG_DEVICE_CODE
+typename shared_extended<table_pow2,advance_pow2,
+                         baseclass,extvalclass,kdd>::result_type
+shared_extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::entry(
+        size_t index) const
+{
+    state_type carry = ticks_ < state_type(horizon_) ? 0U : carry_into(index);
+    ext_state_t state = table_[index];
+    ext_state_t inc   = insideout::external_increment(index+1);
+    if (carry == 0U)
+        return insideout::external_output(state * mult_ + plus_ * inc);
+    result_type value = insideout::external_output(state);
+    insideout::external_advance(value, index+1, ext_state_t(carry + ticks_));
+    return value;
+}
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+P2RNG_DEVICE_CODE
+typename shared_extended<table_pow2,advance_pow2,
+                         baseclass,extvalclass,kdd>::state_type
+shared_extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::
+carry_out(size_t i, state_type carry) const
+{
+    // as in advance_table(ticks_)
+    constexpr bitcount_t basebits = sizeof(state_type)*8;
+    constexpr bitcount_t extbits  = sizeof(ext_state_t)*8;
+    state_type  total_delta = carry + ticks_;
+    ext_state_t trunc_delta = ext_state_t(total_delta);
+    state_type  result = 0U;
+    if (basebits > extbits) {
+        result = total_delta >> extbits;
+    }
+    ext_state_t dist_to_zero = insideout::external_distance(table_[i], i+1);
+    return result + state_type(dist_to_zero <= trunc_delta);
+}
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+P2RNG_DEVICE_CODE
+typename shared_extended<table_pow2,advance_pow2,
+                         baseclass,extvalclass,kdd>::state_type
+shared_extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::
+carry_into(size_t index) const
+{
+    // The carry out of an entry rarely depends on the carry into it, which
+    // is at most max_carry, so we go back only as far as the first entry
+    // where it does not and run the carries forward from there.
+    constexpr bitcount_t basebits = sizeof(state_type)*8;
+    constexpr bitcount_t extbits  = sizeof(ext_state_t)*8;
+    state_type max_carry = 2U;
+    if (basebits > extbits) {
+        max_carry += ticks_ >> extbits;
+    }
+    size_t i = index;
+    state_type carry = 0U;
+    while (i > 0) {
+        --i;
+        state_type lo = carry_out(i, 0U);
+        if (lo == carry_out(i, max_carry)) {
+            carry = lo;
+            ++i;
+            break;
+        }
+    }
+    for (; i < index; ++i)
+        carry = carry_out(i, carry);
+    return carry;
+}
+
+template <bitcount_t table_pow2, bitcount_t advance_pow2,
+          typename baseclass, typename extvalclass, bool kdd>
+P2RNG_DEVICE_CODE
+void shared_extended<table_pow2,advance_pow2,baseclass,extvalclass,kdd>::
+advance(state_type distance)
+{
+    // the ticks extended::advance() applies to its table
+    state_type zero =
+        baseclass::is_mcg ? this->state_ & state_type(3U) : state_type(0U);
+    if (extended_type::may_tick) {
+        state_type ticks =
+            distance >> (advance_pow2*extended_type::may_tick);
+        state_type adv_mask = baseclass::is_mcg
+                            ? extended_type::tick_mask << 2
+                            : extended_type::tick_mask;
+        state_type next_advance_distance = this->distance(zero, adv_mask);
+        if (next_advance_distance < (distance & extended_type::tick_mask)) {
+            ++ticks;
+        }
+        if (ticks)
+            tick(ticks);
+    }
+    if (extended_type::may_tock && this->distance(zero) <= distance)
+        tick(1U);
+    baseclass::advance(distance);
+}
+
 } // namespace pcg_detail
 
 namespace pcg_engines {
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_SERIALIZE_HPP_
+#define _P2RNG_SERIALIZE_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace p2rng {
+
+/**
+ *  @brief Detects if type @a T refers to memory it does not own, as declared
+ *  by a member type @a holds_pointers (e.g. @a trng::discrete_dist_view or
+ *  the PCG @a shared_extended engines), or is a pointer itself. Such types
+ *  may be trivially copyable, but their bytes are meaningless once the
+ *  memory they point to is gone.
+ */
+template <typename T, typename = void>
+struct holds_pointers
+:   std::bool_constant<std::is_pointer_v<T> || std::is_member_pointer_v<T>>
+{};
+
+template <typename T>
+struct holds_pointers<T, std::void_t<typename T::holds_pointers>>
+:   std::true_type
+{};
+
+template <typename T>
+inline constexpr bool holds_pointers_v = holds_pointers<T>::value;
+
+/**
+ *  @brief How objects of type @a T are written to, and read from, a fixed
+ *  number of bytes.
+ *
+ *  Trivially copyable types that hold no pointers (see @a holds_pointers),
+ *  which are all engines but those sharing a table and the @a param_type of
+ *  most distributions, are stored as their object representation. The
+ *  bytes are only meant to be read back by the same build on the same kind
+ *  of machine, as for a checkpoint. A type that holds tables derived from
+ *  its parameters (e.g. @a trng::poisson_dist::param_type) provides
+ *  a static @a serialized_size and the members @a serialize(std::byte*)
+ *  and @a deserialize(const std::byte*), which store the parameters only
+ *  and rebuild the tables on load. Types with tables of arbitrary length,
+ *  such as @a trng::discrete_dist::param_type, have no fixed size and no
+ *  serializer.
+ */
+template <typename T, typename = void>
+struct serializer
+{};
+
+template <typename T>
+struct serializer
+<   T
+,   std::enable_if_t<std::is_trivially_copyable_v<T> && !holds_pointers_v<T>>
+>
+{   static constexpr std::size_t size = sizeof(T);
+
+    static void save(const T& x, std::byte* out)
+    {   std::memcpy(out, &x, size);   }
+
+    static void load(const std::byte* in, T& x)
+    {   std::memcpy(&x, in, size);   }
+
+    // a contiguous array is one contiguous block of bytes
+    static void save(const T* first, std::size_t n, std::byte* out)
+    {   std::memcpy(out, first, n * size);   }
+
+    static void load(const std::byte* in, std::size_t n, T* first)
+    {   std::memcpy(first, in, n * size);   }
+};
+
+template <typename T>
+struct serializer
+<   T
+,   std::enable_if_t
+    <   !std::is_trivially_copyable_v<T>
+    &&  std::is_same_v<decltype(T::serialized_size), const std::size_t>
+    >
+>
+{   static constexpr std::size_t size = T::serialized_size;
+
+    static void save(const T& x, std::byte* out)
+    {   x.serialize(out);   }
+
+    static void load(const std::byte* in, T& x)
+    {   x.deserialize(in);   }
+
+    static void save(const T* first, std::size_t n, std::byte* out)
+    {   for (std::size_t i = 0; i < n; ++i, out += size)
+            first[i].serialize(out);
+    }
+
+    static void load(const std::byte* in, std::size_t n, T* first)
+    {   for (std::size_t i = 0; i < n; ++i, in += size)
+            first[i].deserialize(in);
+    }
+};
+
+/**
+ *  @brief Detects if objects of type @a T can be serialized.
+ */
+template <typename T, typename = void>
+struct is_serializable : std::false_type
+{};
+
+template <typename T>
+struct is_serializable<T, std::void_t<decltype(serializer<T>::size)>>
+:   std::true_type
+{};
+
+template <typename T>
+inline constexpr bool is_serializable_v = is_serializable<T>::value;
+
+/// number of bytes an object of type @a T takes serialized
+template <typename T>
+inline constexpr std::size_t serialized_size_v = serializer<T>::size;
+
+/**
+ *  @brief Writes @a x in binary to @a out, which must have room for
+ *  @a serialized_size_v<T> bytes.
+ *  @return one past the last byte written
+ */
+template <typename T>
+inline std::byte* serialize(const T& x, std::byte* out)
+{   serializer<T>::save(x, out);
+    return out + serialized_size_v<T>;
+}
+
+/**
+ *  @brief Writes the @a n objects starting at @a first in binary to @a out,
+ *  which must have room for @a n * @a serialized_size_v<T> bytes.
+ *  @return one past the last byte written
+ */
+template <typename T>
+inline std::byte* serialize(const T* first, std::size_t n, std::byte* out)
+{   serializer<T>::save(first, n, out);
+    return out + n * serialized_size_v<T>;
+}
+
+/**
+ *  @brief Reads @a x back from the bytes at @a in, written by
+ *  @a serialize().
+ *  @return one past the last byte read
+ */
+template <typename T>
+inline const std::byte* deserialize(const std::byte* in, T& x)
+{   serializer<T>::load(in, x);
+    return in + serialized_size_v<T>;
+}
+
+/**
+ *  @brief Reads @a n objects back from the bytes at @a in, written by
+ *  @a serialize(), to the array starting at @a first.
+ *  @return one past the last byte read
+ */
+template <typename T>
+inline const std::byte* deserialize
+(   const std::byte* in
+,   std::size_t n
+,   T* first
+)
+{   serializer<T>::load(in, n, first);
+    return in + n * serialized_size_v<T>;
+}
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_SERIALIZE_HPP_
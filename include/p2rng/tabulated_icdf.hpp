@@ -0,0 +1,322 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_TABULATED_ICDF_HPP_
+#define _P2RNG_TABULATED_ICDF_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <p2rng/trng/utility.hpp>
+
+namespace p2rng {
+
+/**
+ *  @brief Distribution that samples @a Dist through a table of polynomial
+ *  approximations of @a Dist::icdf(), for distributions that solve for the
+ *  quantile iteratively on every sample, e.g. @a trng::beta_dist or
+ *  @a trng::gamma_dist.
+ *
+ *  Each sample maps one uniform variate @a u in (0, 1), the same kind of
+ *  variate for any @a Dist, through the approximation. The unit interval is
+ *  cut at 1/2 and each half is indexed by @a v = @a u or @a v = 1 - @a u,
+ *  both exact. Every binade [2^-(k+1), 2^-k) of @a v is split into 2^bits
+ *  segments, found from the exponent and the leading mantissa bits of
+ *  @a v, so the segments get finer towards the tails as the quantile
+ *  function gets steeper. On each segment @a icdf() is interpolated by a
+ *  polynomial of degree @a degree at Chebyshev nodes.
+ *
+ *  At construction, each polynomial is checked against @a Dist::icdf() at
+ *  @a checks points spread over its segment, ends included, to half the
+ *  error bound @a tol * (|x| + s), @a s being the interquartile range of
+ *  @a Dist, which leaves room for the error between the points. A segment
+ *  that fails is split in halves, up to 2^max_depth pieces, and calls
+ *  @a Dist::icdf() if they still fail, e.g. where it is not finite, as do
+ *  the tails beyond the tabulated binades (see @a fallback_probability()).
+ *  The table is built once and shared, read only, by all copies.
+ */
+template <typename Dist>
+class tabulated_icdf
+{
+public:
+    typedef Dist                       distribution_type;
+    typedef typename Dist::result_type result_type;
+
+    /// degree of the polynomials
+    static constexpr unsigned degree = 5;
+
+    /// a segment is split in up to 2^max_depth pieces
+    static constexpr unsigned max_depth = 4;
+
+    /// points per polynomial checked against @a Dist::icdf()
+    static constexpr unsigned checks = 64;
+
+    /// default error tolerance, relative to |x| plus the interquartile range
+    static constexpr double default_tolerance
+    =   std::numeric_limits<result_type>::digits > 24 ? 1e-12 : 1e-5;
+
+    /**
+     *  @brief Tabulates the inverse CDF of @a d.
+     *
+     *  @param d    the distribution
+     *  @param tol  error tolerance of the polynomials
+     *  @param bits each binade of @a v has 2^bits segments
+     *
+     *  @throws std::invalid_argument if the interquartile range of @a d is
+     *  not finite
+     */
+    explicit tabulated_icdf
+    (   const Dist& d
+    ,   double tol = default_tolerance
+    ,   unsigned bits = 5
+    )
+    :   _t(std::make_shared<const table>(d, tol, bits))
+    {}
+
+    void reset()
+    {}
+
+    template <typename R>
+    result_type operator() (R& r) const
+    {   return icdf(trng::utility::uniformoo<result_type>(r));   }
+
+    /// batch of random numbers, same as @a n calls to @a operator()(r)
+    template <typename R, typename OutputIt>
+    OutputIt generate(R& r, OutputIt out, std::size_t n) const
+    {   return trng::utility::batch_generate
+        <   trng::utility::u01_kind::oo
+        ,   result_type
+        >
+        (   r
+        ,   out
+        ,   n
+        ,   [this](result_type u) { return icdf(u); }
+        );
+    }
+
+    /// the approximation of @a Dist::icdf(u), for @a u in (0, 1)
+    result_type icdf(result_type u) const
+    {   const table& t = *_t;
+        const bool upper = u > result_type(0.5);
+        const double v = upper ? 1.0 - double(u) : double(u);
+        const std::uint64_t b = to_bits(v);
+        const std::uint64_t key = b >> t.shift;
+        if (key < t.key_min)
+            return t.d.icdf(u);
+        std::size_t i = std::size_t(key - t.key_min);
+        double x = 1.0;
+        if (i < t.per_side)
+            x = std::ldexp(double(b & t.mask), 1 - int(t.shift)) - 1.0;
+        else
+            i = t.per_side - 1;
+        if (upper)
+            i += t.per_side;
+        const segment& s = t.seg[i];
+        if (s.half == 0)
+            return t.d.icdf(u);
+        // the piece of the segment, and x on it, both exact
+        const double y = (x + 1) * s.half;
+        const double j = std::min(std::floor(y), 2 * s.half - 1);
+        x = 2 * (y - j) - 1;
+        const double* c = &t.c[(s.first + std::size_t(j)) * (degree + 1)];
+        double p = c[degree];
+        for (unsigned k = degree; k-- > 0; )
+            p = p * x + c[k];
+        return result_type(p);
+    }
+
+    result_type min() const
+    {   return _t->d.min();   }
+    result_type max() const
+    {   return _t->d.max();   }
+
+    const Dist& distribution() const
+    {   return _t->d;   }
+    double tolerance() const
+    {   return _t->tol;   }
+
+    /// probability that a sample calls @a Dist::icdf()
+    double fallback_probability() const
+    {   return _t->fallback;   }
+
+private:
+    static std::uint64_t to_bits(double v)
+    {   std::uint64_t b;
+        std::memcpy(&b, &v, sizeof(b));
+        return b;
+    }
+
+    static double from_bits(std::uint64_t b)
+    {   double v;
+        std::memcpy(&v, &b, sizeof(v));
+        return v;
+    }
+
+    struct segment
+    {   std::size_t first;  // its first piece
+        double      half;   // half its number of pieces, 0 calls Dist::icdf()
+    };
+
+    struct table
+    {   Dist                 d;
+        double               tol;
+        unsigned             shift;     // 52 - bits
+        std::uint64_t        mask;      // mantissa bits below the index
+        std::uint64_t        key_min;   // index bits of the smallest v
+        std::size_t          per_side;
+        std::vector<segment> seg;
+        std::vector<double>  c;         // coefficients, per piece
+        double               fallback = 0;
+
+        table(const Dist& dist, double tolerance, unsigned bits)
+        :   d(dist)
+        ,   tol(tolerance)
+        ,   shift(52 - bits)
+        ,   mask((std::uint64_t(1) << (52 - bits)) - 1)
+        {   // the narrowest segments hold at least 2^6 values of u
+            const int digits = std::numeric_limits<result_type>::digits;
+            const int binades = std::min(40, digits - int(bits) - 7);
+            const double v_min = std::ldexp(1.0, -(binades + 1));
+            key_min = to_bits(v_min) >> shift;
+            per_side = std::size_t(binades) << bits;
+            seg.resize(2 * per_side);
+            fallback = 2 * v_min;
+
+            const double s = std::abs
+            (   double(d.icdf(result_type(0.75)))
+            -   double(d.icdf(result_type(0.25)))
+            );
+            if (!std::isfinite(s))
+                throw std::invalid_argument
+                (   "non-finite interquartile range for p2rng::tabulated_icdf"   );
+            std::vector<double> coef;
+            for (std::size_t i = 0; i < 2 * per_side; ++i)
+            {   const bool upper = i >= per_side;
+                const std::uint64_t key = key_min + i % per_side;
+                const double v0 = from_bits(key << shift);
+                const double w = std::ldexp(from_bits((key >> bits) << 52), -int(bits));
+                const int depth = split(upper, v0, w, s, coef);
+                if (depth < 0)
+                {   seg[i] = {0, 0};
+                    fallback += w;
+                }
+                else
+                {   seg[i] = {c.size() / (degree + 1), std::ldexp(0.5, depth)};
+                    c.insert(c.end(), coef.begin(), coef.end());
+                }
+            }
+        }
+
+        // fits the segment [v0, v0 + w) by the fewest pieces, 2^depth, that
+        // each hold at least 2^6 values of u, returns -1 if none do
+        int split
+        (   bool upper
+        ,   double v0
+        ,   double w
+        ,   double s
+        ,   std::vector<double>& coef
+        )   const
+        {   const int digits = std::numeric_limits<result_type>::digits;
+            for (int depth = 0; depth <= int(max_depth); ++depth)
+            {   const std::size_t m = std::size_t(1) << depth;
+                const double wp = std::ldexp(w, -depth);
+                if (std::ldexp(wp, digits) < 64)
+                    break;
+                coef.resize(m * (degree + 1));
+                std::size_t j = 0;
+                while (j < m && fit(upper, v0 + double(j) * wp, wp, s, &coef[j * (degree + 1)]))
+                    ++j;
+                if (j == m)
+                    return depth;
+            }
+            return -1;
+        }
+
+        // samples icdf() near x in [-1, 1] of the segment [v0, v0 + w),
+        // returns the actual position, u being rounded to result_type
+        std::pair<double, double>
+        sample(bool upper, double v0, double w, double x) const
+        {   const double v = v0 + (x + 1) / 2 * w;
+            const result_type u = result_type(upper ? 1.0 - v : v);
+            const double va = upper ? 1.0 - double(u) : double(u);
+            return {2 * (va - v0) / w - 1, double(d.icdf(u))};
+        }
+
+        bool fit(bool upper, double v0, double w, double s, double* coef) const
+        {   constexpr unsigned n = degree + 1;
+            constexpr double pi = 3.14159265358979323846;
+            double a[n][n + 1];
+            for (unsigned j = 0; j < n; ++j)
+            {   auto [x, y] = sample(upper, v0, w, std::cos((2 * j + 1) * pi / (2 * n)));
+                if (!std::isfinite(y))
+                    return false;
+                double p = 1;
+                for (unsigned k = 0; k < n; ++k, p *= x)
+                    a[j][k] = p;
+                a[j][n] = y;
+            }
+            // Gaussian elimination with partial pivoting
+            for (unsigned k = 0; k < n; ++k)
+            {   unsigned m = k;
+                for (unsigned j = k + 1; j < n; ++j)
+                    if (std::abs(a[j][k]) > std::abs(a[m][k]))
+                        m = j;
+                for (unsigned l = 0; l <= n; ++l)
+                    std::swap(a[k][l], a[m][l]);
+                for (unsigned j = k + 1; j < n; ++j)
+                {   const double f = a[j][k] / a[k][k];
+                    for (unsigned l = k; l <= n; ++l)
+                        a[j][l] -= f * a[k][l];
+                }
+            }
+            for (unsigned k = n; k-- > 0; )
+            {   double y = a[k][n];
+                for (unsigned l = k + 1; l < n; ++l)
+                    y -= a[k][l] * coef[l];
+                coef[k] = y / a[k][k];
+            }
+            // error between the nodes and at the ends
+            for (unsigned j = 0; j <= checks; ++j)
+            {   auto [x, y] = sample(upper, v0, w, (2.0 * j - checks) / checks);
+                double p = coef[degree];
+                for (unsigned k = degree; k-- > 0; )
+                    p = p * x + coef[k];
+                if (!(std::abs(p - y) <= tol / 2 * (std::abs(y) + s)))
+                    return false;
+            }
+            return true;
+        }
+    };
+
+    std::shared_ptr<const table> _t;
+};
+
+} // end p2rng namespace
+
+#endif  // _P2RNG_TABULATED_ICDF_HPP_
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_TRAITS_HPP_
+#define _P2RNG_TRAITS_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace p2rng {
+
+/**
+ *  @brief Detects if generator @a G has a bulk @a fill(out, n) member that
+ *  writes the next @a n values to @a out exactly as @a n calls to
+ *  @a operator() would.
+ */
+template <typename G, typename OutputIt, typename = void>
+struct has_fill : std::false_type
+{};
+
+template <typename G, typename OutputIt>
+struct has_fill
+<   G
+,   OutputIt
+,   std::void_t<decltype
+    (   std::declval<G&>().fill(std::declval<OutputIt>(), std::size_t{})
+    )>
+>   : std::true_type
+{};
+
+template <typename G, typename OutputIt>
+inline constexpr bool has_fill_v = has_fill<G, OutputIt>::value;
+
+/**
+ *  @brief Detects if generator @a G has a @a leapfrog(stride) member that
+ *  returns a generator yielding every @a stride-th value of @a G, starting
+ *  with the next one (e.g. PCG engines and the TRNG engines that can be
+ *  split).
+ */
+template <typename G, typename = void>
+struct has_leapfrog : std::false_type
+{};
+
+template <typename G>
+struct has_leapfrog
+<   G
+,   std::void_t<decltype
+    (   std::declval<const G&>().leapfrog(std::size_t{})
+    )>
+>   : std::true_type
+{};
+
+template <typename G>
+inline constexpr bool has_leapfrog_v = has_leapfrog<G>::value;
+
+/**
+ *  @brief Detects if @a It is a pointer or a @a std::vector iterator to a
+ *  non-bool arithmetic type, i.e. an iterator over contiguous memory that can
+ *  be written with raw (e.g. streaming) stores.
+ */
+template <typename It, typename = void>
+struct is_contiguous_arithmetic : std::false_type
+{};
+
+template <typename It>
+struct is_contiguous_arithmetic
+<   It
+,   std::enable_if_t
+    <   std::is_arithmetic_v<typename std::iterator_traits<It>::value_type>
+    &&  !std::is_same_v<typename std::iterator_traits<It>::value_type, bool>
+    >
+>   : std::bool_constant
+    <   std::is_pointer_v<It>
+    ||  std::is_same_v
+        <   It
+        ,   typename std::vector
+            <   typename std::iterator_traits<It>::value_type
+            >::iterator
+        >
+    >
+{};
+
+template <typename It>
+inline constexpr bool is_contiguous_arithmetic_v
+=   is_contiguous_arithmetic<It>::value;
+
+/**
+ *  @brief Rough cost class of producing one random number, relative to a call
+ *  to a PCG engine. The parallel algorithms use it to decide how many threads
+ *  a small output is worth.
+ *
+ *  @a cheap is an engine call or a few arithmetic operations on it (e.g.
+ *  uniform distributions), @a moderate a transcendental function or a table
+ *  lookup (the default for distributions), @a expensive an iterative inverse
+ *  (e.g. Newton steps on an incomplete gamma or beta function).
+ */
+enum class cost_class
+{   cheap
+,   moderate
+,   expensive
+};
+
+template<typename Distribution, typename Engine>
+struct bind_struct;
+
+/**
+ *  @brief Cost class of one sample of distribution @a D, as declared by its
+ *  static member @a sample_cost, or @a cost_class::moderate without one.
+ */
+template <typename D, typename = void>
+struct distribution_cost
+:   std::integral_constant<cost_class, cost_class::moderate>
+{};
+
+template <typename D>
+struct distribution_cost<D, std::void_t<decltype(D::sample_cost)>>
+:   std::integral_constant<cost_class, D::sample_cost>
+{};
+
+/**
+ *  @brief Cost class of one call to generator @a G: @a cost_class::cheap for
+ *  a random number engine, that of the distribution for a bind object.
+ */
+template <typename G>
+struct sample_cost
+:   std::integral_constant<cost_class, cost_class::cheap>
+{};
+
+template <typename D, typename E>
+struct sample_cost<bind_struct<D, E>>
+:   distribution_cost<D>
+{};
+
+template <typename G>
+inline constexpr cost_class sample_cost_v = sample_cost<G>::value;
+
+/**
+ *  @brief Number of calls to engine @a E per sample of distribution @a D, as
+ *  declared by its static member template @a draws, or one without it. Bind
+ *  objects scale their @a discard() by it, so that the parallel algorithms
+ *  can skip whole samples.
+ */
+template <typename D, typename E, typename = void>
+struct draws_per_sample
+:   std::integral_constant<std::size_t, 1>
+{};
+
+template <typename D, typename E>
+struct draws_per_sample
+<   D
+,   E
+,   std::void_t<decltype(D::template draws<E>)>
+>   : std::integral_constant<std::size_t, D::template draws<E>>
+{};
+
+template <typename D, typename E>
+inline constexpr std::size_t draws_per_sample_v = draws_per_sample<D, E>::value;
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_TRAITS_HPP_
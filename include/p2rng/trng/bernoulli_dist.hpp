@@ -35,6 +35,7 @@
 #define TRNG_BERNOULLI_DIST_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <ostream>
@@ -49,6 +50,8 @@ namespace trng {
   class bernoulli_dist {
   public:
     using result_type = T;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::cheap};
 
     class param_type {
       template<typename type>
@@ -164,6 +167,12 @@ namespace trng {
       bernoulli_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [this](double x) { return x < P.p() ? P.head() : P.tail(); });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     T min() const {
@@ -37,10 +37,14 @@
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/math.hpp>
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <istream>
 #include <iomanip>
 #include <vector>
+#include <cstdint>
+#include <memory>
 #include <ciso646>
 
 namespace trng {
@@ -54,10 +58,25 @@ namespace trng {
     private:
       double p_{0.5};
       int n_{0};
+      // cumulative density function over [0, n] with its guide table for n < full_size, ...
       std::vector<double> P_;
+      std::vector<std::uint32_t> G_;
+      // ... or its window, shared by all copies
+      std::shared_ptr<const utility::cdf_window> W_;
 
+      double up(int x) const { return (n_ - x) / (x + 1.0) * (p_ / (1.0 - p_)); }
+      double down(int x) const { return x / (n_ - x + 1.0) * ((1.0 - p_) / p_); }
       void calc_probabilities() {
         P_ = std::vector<double>();
+        G_ = std::vector<std::uint32_t>();
+        W_.reset();
+        if (n_ >= utility::cdf_window::full_size) {
+          const int mode{static_cast<int>((n_ + 1.0) * p_)};
+          W_ = std::make_shared<const utility::cdf_window>(
+              mode < n_ ? mode : n_, n_, [this](int x) { return up(x); },
+              [this](int x) { return down(x); });
+          return;
+        }
         P_.reserve(n_ + 1);
         double ln_binom{0.0};
         const double ln_p{math::ln(p_)};
@@ -75,6 +94,12 @@ namespace trng {
         // normailze, just in case of rounding errors
         for (std::vector<double>::size_type i{0}; i < P_.size(); ++i)
           P_[i] /= P_.back();
+        G_ = utility::discrete_guide(P_.begin(), P_.end(), utility::cdf_window::full_guide);
+      }
+      int icdf(double u) const {
+        if (not W_)
+          return static_cast<int>(utility::discrete(u, P_.begin(), P_.end(), G_));
+        return W_->icdf(u, [this](int x) { return up(x); }, [this](int x) { return down(x); });
       }
 
     public:
@@ -88,8 +113,21 @@ namespace trng {
         n_ = n_new;
         calc_probabilities();
       }
-      param_type() = default;
+      param_type() { calc_probabilities(); }
       explicit param_type(double p, int n) : p_(p), n_(n) { calc_probabilities(); }
+      // binary checkpoint (see p2rng::serializer), the parameters only
+      static constexpr std::size_t serialized_size{sizeof(p_) + sizeof(n_)};
+      void serialize(std::byte *out) const {
+        std::memcpy(out, &p_, sizeof(p_));
+        out += sizeof(p_);
+        std::memcpy(out, &n_, sizeof(n_));
+      }
+      void deserialize(const std::byte *in) {
+        std::memcpy(&p_, in, sizeof(p_));
+        in += sizeof(p_);
+        std::memcpy(&n_, in, sizeof(n_));
+        calc_probabilities();
+      }
       friend class binomial_dist;
     };
 
@@ -105,14 +143,19 @@ namespace trng {
     // random numbers
     template<typename R>
     int operator()(R &r) {
-      return static_cast<int>(
-          utility::discrete(utility::uniformoo<double>(r), P.P_.begin(), P.P_.end()));
+      return P.icdf(utility::uniformoo<double>(r));
     }
     template<typename R>
     int operator()(R &r, const param_type &P) {
       binomial_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, double>(
+          r, out, n, [this](double x) { return P.icdf(x); });
+    }
     // property methods
     int min() const { return 0; }
     int max() const { return P.n(); }
@@ -124,6 +167,9 @@ namespace trng {
     void n(int n_new) { P.n(n_new); }
     // probability density function
     double pdf(int x) const {
+      if (P.W_)
+        return P.W_->pdf(x, [this](int y) { return P.up(y); },
+                         [this](int y) { return P.down(y); });
       if (x < 0 or x > P.n())
         return 0.0;
       if (x == 0)
@@ -132,6 +178,9 @@ namespace trng {
     }
     // cumulative density function
     double cdf(int x) const {
+      if (P.W_)
+        return P.W_->cdf(x, [this](int y) { return P.up(y); },
+                         [this](int y) { return P.down(y); });
       if (x < 0)
         return 0.0;
       if (x <= P.n())
@@ -139,6 +139,12 @@ namespace trng {
       cauchy_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, result_type>(
+          r, out, n, [this](result_type x) { return icdf_(x); });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     result_type min() const { return -math::numeric_limits<result_type>::infinity(); }
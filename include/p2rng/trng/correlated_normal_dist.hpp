@@ -153,6 +153,14 @@ namespace trng {
     param_type P;
     std::vector<result_type> normal_;
 
+    result_type next_(result_type x) {
+      normal_.push_back(trng::math::inv_Phi(x));
+      result_type y{P.H_times(normal_)};
+      if (normal_.size() == P.d())
+        normal_.clear();
+      return y;
+    }
+
   public:
     // constructor
     template<typename iter>
@@ -163,17 +171,19 @@ namespace trng {
     // random numbers
     template<typename R>
     result_type operator()(R &r) {
-      normal_.push_back(trng::math::inv_Phi(utility::uniformoo<result_type>(r)));
-      result_type y{P.H_times(normal_)};
-      if (normal_.size() == P.d())
-        normal_.clear();
-      return y;
+      return next_(utility::uniformoo<result_type>(r));
     }
     template<typename R>
     result_type operator()(R &r, const param_type &P) {
       correlated_normal_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, result_type>(
+          r, out, n, [this](result_type x) { return next_(x); });
+    }
     // property methods
     result_type min() const { return -math::numeric_limits<result_type>::infinity(); }
     result_type max() const { return math::numeric_limits<result_type>::infinity(); }
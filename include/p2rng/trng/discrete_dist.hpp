@@ -34,19 +34,100 @@
 
 #define TRNG_DISCRETE_DIST_HPP
 
+#include <p2rng/device.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/int_math.hpp>
+#include <cstddef>
 #include <ostream>
 #include <iomanip>
 #include <istream>
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <type_traits>
 #include <ciso646>
 
 namespace trng {
 
+  // sampling view of a discrete_dist, refers to the distribution's tree of partial sums
+  // instead of holding a copy; it is trivially copyable and can be used in device code with
+  // the tree copied to device memory (see tree() and tree_size()); the distribution must
+  // outlive the view and its weights must not change while the view is in use, changes made
+  // before are seen by the view
+  class discrete_dist_view {
+  public:
+    using result_type = int;
+    using size_type = std::size_t;
+    // refers to the tree, so it is not serializable (see p2rng::holds_pointers)
+    using holds_pointers = std::true_type;
+
+  private:
+    const double *P_{nullptr};
+    size_type N_{0}, offset_{0};
+
+  public:
+    // inversion by descending the tree P with offset internal nodes
+    P2RNG_DEVICE_CODE
+    static int icdf(const double *P, size_type offset, double u) {
+      u *= P[0];
+      size_type x{0};
+      while (x < offset) {
+        if (u < P[2 * x + 1]) {
+          x = 2 * x + 1;
+        } else {
+          u -= P[2 * x + 1];
+          x = 2 * x + 2;
+        }
+      }
+      return static_cast<int>(x - offset);
+    }
+
+    // constructor
+    discrete_dist_view() = default;
+    // view of the tree of a distribution of n weights
+    P2RNG_DEVICE_CODE
+    discrete_dist_view(const double *tree, size_type n)
+        : P_{tree}, N_{n}, offset_{int_math::pow2(int_math::log2_ceil(n)) - 1} {}
+    // reset internal state
+    P2RNG_DEVICE_CODE
+    void reset() {}
+    // random numbers
+    template<typename R>
+    P2RNG_DEVICE_CODE int operator()(R &r) {
+      if (N_ == 0)
+        return -1;
+      return icdf(P_, offset_, utility::uniformco<double>(r));
+    }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      if (N_ == 0) {
+        for (std::size_t i{0}; i < n; ++i, ++out)
+          *out = -1;
+        return out;
+      }
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [P = P_, offset = offset_](double x) { return icdf(P, offset, x); });
+    }
+    // property methods
+    P2RNG_DEVICE_CODE
+    int min() const { return 0; }
+    P2RNG_DEVICE_CODE
+    int max() const { return static_cast<int>(N_ - 1); }
+    P2RNG_DEVICE_CODE
+    const double *tree() const { return P_; }
+    P2RNG_DEVICE_CODE
+    size_type tree_size() const { return N_ + offset_; }
+    // probability density function
+    P2RNG_DEVICE_CODE
+    double pdf(int x) const {
+      return (x < 0 or x >= static_cast<int>(N_)) ? 0.0 : P_[x + offset_] / P_[0];
+    }
+  };
+
+  // -------------------------------------------------------------------
+
   // non-uniform random number generator class
   class discrete_dist {
   public:
@@ -111,6 +192,14 @@ namespace trng {
   private:
     param_type P;
 
+    int icdf_(double u) const { return discrete_dist_view::icdf(P.P_.data(), P.offset_, u); }
+
+    // parent node i from its children, the right one may be missing
+    void update_node(param_type::size_type i) {
+      const param_type::size_type right{2 * i + 2};
+      P.P_[i] = P.P_[2 * i + 1] + (right < P.P_.size() ? P.P_[right] : 0.0);
+    }
+
   public:
     // constructor
     template<typename iter>
@@ -124,23 +213,24 @@ namespace trng {
     int operator()(R &r) {
       if (P.N_ == 0)
         return -1;
-      double u(utility::uniformco<double>(r) * P.P_[0]);
-      param_type::size_type x{0};
-      while (x < P.offset_) {
-        if (u < P.P_[2 * x + 1]) {
-          x = 2 * x + 1;
-        } else {
-          u -= P.P_[2 * x + 1];
-          x = 2 * x + 2;
-        }
-      }
-      return static_cast<int>(x - P.offset_);
+      return icdf_(utility::uniformco<double>(r));
     }
     template<typename R>
     int operator()(R &r, const param_type &p) {
       discrete_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      if (P.N_ == 0) {
+        for (std::size_t i{0}; i < n; ++i, ++out)
+          *out = -1;
+        return out;
+      }
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [this](double x) { return icdf_(x); });
+    }
     // property methods
     int min() const { return 0; }
     int max() const { return static_cast<int>(P.N_ - 1); }
@@ -152,10 +242,38 @@ namespace trng {
       if (x > 0) {
         do {
           x = (x - 1) / 2;
-          P.P_[x] = P.P_[2 * x + 1] + P.P_[2 * x + 2];
+          update_node(x);
         } while (x > 0);
       }
     }
+    // sets the weights of the categories [x_first, x_last) to the ones from p_first on and
+    // updates each partial sum above them once, layer by layer; the whole tree is rebuilt
+    // if that is cheaper
+    template<typename IterX, typename IterP>
+    void param(IterX x_first, IterX x_last, IterP p_first) {
+      using size_type = param_type::size_type;
+      std::vector<size_type> nodes;
+      for (; x_first != x_last; ++x_first, ++p_first) {
+        const size_type i{static_cast<size_type>(*x_first) + P.offset_};
+        P.P_[i] = *p_first;
+        nodes.push_back(i);
+      }
+      if (nodes.size() * P.layers_ >= P.N_) {
+        P.update_all_layers();
+        return;
+      }
+      // all leaves are in the last layer, so the nodes stay in one layer
+      while (not nodes.empty() and nodes.front() > 0) {
+        for (auto &i : nodes)
+          i = (i - 1) / 2;
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        for (auto i : nodes)
+          update_node(i);
+      }
+    }
+    // sampling view sharing the tree of partial sums
+    discrete_dist_view view() const { return discrete_dist_view(P.P_.data(), P.N_); }
     // probability density function
     double pdf(int x) const {
       return (x < 0 or x >= static_cast<int>(P.N_)) ? 0.0 : P.P_[x + P.offset_] / P.P_[0];
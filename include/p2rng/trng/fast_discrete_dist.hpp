@@ -41,66 +41,297 @@
 // The American Statistician, Vol. 33, No. 4. (Nov., 1979), pp. 214-218.
 //
 // http://links.jstor.org/sici?sici=0003-1305%28197911%2933%3A4%3C214%3AOTAMFG%3E2.0.CO%3B2-1
+//
+// Serially, the table is built in a single pass as by TRNG.  In parallel, which is done only
+// if an executor is passed, it is built in blocks of block_size weights that are paired up
+// independently, the columns left over in each block are paired up across blocks at the
+// end.  Up to block_size weights both give the same table, beyond that the pairs, and so
+// the sequences drawn, differ.
 
+#include <p2rng/device.hpp>
+#include <p2rng/executor.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/math.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <ostream>
 #include <iomanip>
 #include <istream>
 #include <vector>
 #include <numeric>
 #include <functional>
+#include <type_traits>
 #include <ciso646>
 
 namespace trng {
 
+  // column of an alias table: the column's own index is sampled if the fractional part of
+  // the scaled uniform variate does not exceed the threshold, the alias otherwise; with
+  // float thresholds an entry takes 8 bytes and each sample reads a single entry
+  template<typename T = float>
+  struct alias_entry {
+    T threshold;
+    std::uint32_t alias;
+  };
+
+  // sampling view of an alias table, refers to the table's entries instead of holding a
+  // copy; it is trivially copyable and can be used in device code with the entries copied
+  // to device memory (see data() and size()); the table must outlive the view
+  template<typename T = float>
+  class fast_discrete_dist_view {
+  public:
+    using result_type = int;
+    using size_type = std::size_t;
+    using entry_type = alias_entry<T>;
+    // refers to the table, so it is not serializable (see p2rng::holds_pointers)
+    using holds_pointers = std::true_type;
+
+  private:
+    const entry_type *E_{nullptr};
+    size_type N_{0};
+
+  public:
+    // inversion by the alias method
+    P2RNG_DEVICE_CODE
+    static int icdf(const entry_type *E, size_type n, double u) {
+      const double U{u * n};
+      size_type I{static_cast<size_type>(U)};
+      if (I >= n)  // u * n may round up to n
+        I = n - 1;
+      const entry_type e{E[I]};
+      return U - I <= e.threshold ? static_cast<int>(I) : static_cast<int>(e.alias);
+    }
+
+    // constructor
+    fast_discrete_dist_view() = default;
+    // view of the n entries of an alias table
+    P2RNG_DEVICE_CODE
+    fast_discrete_dist_view(const entry_type *entries, size_type n) : E_{entries}, N_{n} {}
+    // reset internal state
+    P2RNG_DEVICE_CODE
+    void reset() {}
+    // random numbers
+    template<typename R>
+    P2RNG_DEVICE_CODE int operator()(R &r) {
+      return icdf(E_, N_, utility::uniformco<double>(r));
+    }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [E = E_, N = N_](double x) { return icdf(E, N, x); });
+    }
+    // property methods
+    P2RNG_DEVICE_CODE
+    int min() const { return 0; }
+    P2RNG_DEVICE_CODE
+    int max() const { return static_cast<int>(N_ - 1); }
+    P2RNG_DEVICE_CODE
+    const entry_type *data() const { return E_; }
+    P2RNG_DEVICE_CODE
+    size_type size() const { return N_; }
+  };
+
+  // -------------------------------------------------------------------
+
+  // alias table of a discrete distribution, read only once built; threads share it through
+  // fast_discrete_dist_view (see view()); a table built in parallel does not depend on the
+  // number of threads, but differs from the serial one for more than block_size weights
+  template<typename T = float>
+  class alias_table {
+  public:
+    using entry_type = alias_entry<T>;
+    using size_type = std::size_t;
+    using view_type = fast_discrete_dist_view<T>;
+
+    // number of weights paired up independently of the other weights in a parallel build
+    static constexpr size_type block_size{size_type(1) << 16};
+
+  private:
+    std::vector<entry_type> E_;
+
+    // pairs up small columns (F < 1) with large ones until either kind is used up
+    static void pair_up(std::vector<double> &F, std::vector<entry_type> &E,
+                        std::vector<std::uint32_t> &S, std::vector<std::uint32_t> &G) {
+      while ((not S.empty()) and (not G.empty())) {
+        const std::uint32_t k{G.back()}, j{S.back()};
+        E[j].alias = k;
+        F[k] -= 1.0 - F[j];
+        S.pop_back();
+        if (F[k] < 1.0) {
+          G.pop_back();
+          S.push_back(k);
+        }
+      }
+    }
+
+    // the columns left over after the pairing are full up to rounding
+    static void fill_up(std::vector<double> &F, std::vector<entry_type> &E,
+                        const std::vector<std::uint32_t> &S,
+                        const std::vector<std::uint32_t> &G) {
+      for (const auto i : S) {
+        F[i] = 1.0;
+        E[i].alias = i;
+      }
+      for (const auto i : G) {
+        F[i] = 1.0;
+        E[i].alias = i;
+      }
+    }
+
+    // builds the table from the weights F, which are overwritten, in a single pass
+    void build(std::vector<double> &F) {
+      const size_type n{F.size()};
+      const double s{std::accumulate(F.begin(), F.end(), 0.0)};
+      if (not(s > 0.0))
+        return;
+      std::vector<std::uint32_t> S, G;
+      S.reserve(n);
+      G.reserve(n);
+      for (size_type i{0}; i < n; ++i) {
+        F[i] = n * (F[i] / s);
+        if (F[i] < 1.0)
+          S.push_back(static_cast<std::uint32_t>(i));
+        else
+          G.push_back(static_cast<std::uint32_t>(i));
+      }
+      pair_up(F, E_, S, G);
+      fill_up(F, E_, S, G);
+      for (size_type i{0}; i < n; ++i)
+        E_[i].threshold = static_cast<T>(F[i]);
+    }
+
+    // builds the table from the weights F, which are overwritten, in blocks on the threads
+    // of ex if given, in a single pass otherwise
+    void build(p2rng::executor *ex, std::vector<double> &F) {
+      const size_type n{F.size()};
+      if (n > size_type(std::numeric_limits<std::uint32_t>::max()) + 1)
+        utility::throw_this(std::length_error("too many weights for trng::alias_table"));
+      E_.assign(n, entry_type{T(0), 0});
+      if (n == 0)
+        return;
+      if (not ex) {
+        build(F);
+        return;
+      }
+      const size_type blocks{(n + block_size - 1) / block_size};
+      auto for_blocks = [ex, blocks](auto f) {
+        ex->run([&f, blocks](std::size_t tidx, std::size_t team) {
+          for (size_type b{tidx}; b < blocks; b += team)
+            f(b);
+        });
+      };
+      // sum of the weights, added up in the same order for any number of threads
+      std::vector<double> sums(blocks);
+      for_blocks([&](size_type b) {
+        const auto first{F.begin() + b * block_size};
+        const auto last{F.begin() + std::min(n, (b + 1) * block_size)};
+        sums[b] = std::accumulate(first, last, 0.0);
+      });
+      const double s{std::accumulate(sums.begin(), sums.end(), 0.0)};
+      if (not(s > 0.0))
+        return;
+      // pair up within blocks, keep the columns left over
+      std::vector<std::vector<std::uint32_t>> rest(blocks);
+      for_blocks([&](size_type b) {
+        const size_type first{b * block_size}, last{std::min(n, (b + 1) * block_size)};
+        std::vector<std::uint32_t> S, G;
+        S.reserve(last - first);
+        G.reserve(last - first);
+        for (size_type i{first}; i < last; ++i) {
+          F[i] = n * (F[i] / s);
+          if (F[i] < 1.0)
+            S.push_back(static_cast<std::uint32_t>(i));
+          else
+            G.push_back(static_cast<std::uint32_t>(i));
+        }
+        pair_up(F, E_, S, G);
+        rest[b].insert(rest[b].end(), S.begin(), S.end());
+        rest[b].insert(rest[b].end(), G.begin(), G.end());
+      });
+      // pair up the columns left over, whatever remains is full up to rounding
+      std::vector<std::uint32_t> S, G;
+      for (const auto &r : rest)
+        for (const auto i : r)
+          (F[i] < 1.0 ? S : G).push_back(i);
+      pair_up(F, E_, S, G);
+      fill_up(F, E_, S, G);
+      for_blocks([&](size_type b) {
+        const size_type last{std::min(n, (b + 1) * block_size)};
+        for (size_type i{b * block_size}; i < last; ++i)
+          E_[i].threshold = static_cast<T>(F[i]);
+      });
+    }
+
+  public:
+    // constructors
+    alias_table() = default;
+    // builds the table serially, as TRNG, whatever the number of weights
+    template<typename iter>
+    alias_table(iter first, iter last) {
+      std::vector<double> F(first, last);
+      build(nullptr, F);
+    }
+    // builds the table in parallel on the threads of executor ex
+    template<typename iter>
+    alias_table(p2rng::executor &ex, iter first, iter last) {
+      std::vector<double> F(first, last);
+      build(&ex, F);
+    }
+    // property methods
+    size_type size() const { return E_.size(); }
+    const entry_type *data() const { return E_.data(); }
+    const entry_type &operator[](size_type i) const { return E_[i]; }
+    // sampling view sharing the table
+    view_type view() const { return view_type(E_.data(), E_.size()); }
+  };
+
+  // -------------------------------------------------------------------
+
   // non-uniform random number generator class
   class fast_discrete_dist {
   public:
     using result_type = int;
+    using view_type = fast_discrete_dist_view<double>;
 
     class param_type {
     private:
       using size_type = std::vector<double>::size_type;
-      std::vector<double> P, F;
-      std::vector<int> L;
-      size_type N{0};
+      // normalized weights and their alias table, shared read only by all copies
+      struct table_type {
+        std::vector<double> P;
+        alias_table<double> T;
+      };
+      std::shared_ptr<const table_type> D;
 
-      explicit param_type(std::vector<double> P)
-          : P(std::move(P)), F(P.size()), L(P.size()), N(P.size()) {
+      static std::shared_ptr<const table_type> make(p2rng::executor *ex,
+                                                    std::vector<double> P) {
+        auto D_new{std::make_shared<table_type>()};
+        // from the weights as given, normalizing them first would add a rounding step
+        D_new->T = ex ? alias_table<double>(*ex, P.begin(), P.end())
+                      : alias_table<double>(P.begin(), P.end());
         const double s{std::accumulate(P.begin(), P.end(), 0.0)};
-        if (s > 0.0) {
+        if (s > 0.0)
           for (auto &val : P)
             val /= s;
-          std::vector<int> G, S;
-          G.reserve(N);
-          S.reserve(N);
-          for (int i{0}; i < F.size(); ++i) {
-            F[i] = N * P[i];
-            if (F[i] < 1.0)
-              S.push_back(i);
-            else
-              G.push_back(i);
-          }
-          while ((not S.empty()) and (not G.empty())) {
-            const int k{G.back()}, j{S.back()};
-            L[j] = k;
-            F[k] -= 1.0 - F[j];
-            S.pop_back();
-            if (F[k] < 1.0) {
-              G.pop_back();
-              S.push_back(k);
-            }
-          }
-        }
+        D_new->P = std::move(P);
+        return D_new;
       }
+      size_type N() const { return D->P.size(); }
 
     public:
-      param_type() = default;
+      param_type() : D{std::make_shared<const table_type>()} {}
       template<typename iter>
       explicit param_type(iter first, iter last)
-          : param_type{std::vector<double>(first, last)} {}
-      explicit param_type(int n) : param_type{std::vector<double>(n, 1.0)} {}
+          : D{make(nullptr, std::vector<double>(first, last))} {}
+      // builds the alias table in parallel on the threads of executor ex
+      template<typename iter>
+      explicit param_type(p2rng::executor &ex, iter first, iter last)
+          : D{make(&ex, std::vector<double>(first, last))} {}
+      explicit param_type(int n) : D{make(nullptr, std::vector<double>(n, 1.0))} {}
 
       friend class fast_discrete_dist;
       friend bool operator==(const param_type &, const param_type &);
@@ -115,10 +346,18 @@ namespace trng {
   private:
     param_type P;
 
+    int icdf_(double u) const {
+      return view_type::icdf(P.D->T.data(), P.D->T.size(), u);
+    }
+
   public:
     // constructor
     template<typename iter>
     explicit fast_discrete_dist(iter first, iter last) : P{first, last} {}
+    // builds the alias table in parallel on the threads of executor ex
+    template<typename iter>
+    explicit fast_discrete_dist(p2rng::executor &ex, iter first, iter last)
+        : P{ex, first, last} {}
     explicit fast_discrete_dist(int N) : P{N} {}
     explicit fast_discrete_dist(const param_type &P) : P{P} {}
     // reset internal state
@@ -126,28 +365,33 @@ namespace trng {
     // random numbers
     template<typename R>
     int operator()(R &r) {
-      const double U{utility::uniformco<double>(r) * P.N};
-      const int I{static_cast<int>(U)};
-      return U - I <= P.F[I] ? I : P.L[I];
+      return icdf_(utility::uniformco<double>(r));
     }
     template<typename R>
     int operator()(R &r, const param_type &P) {
       fast_discrete_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return view().generate(r, out, n);
+    }
     // property methods
     int min() const { return 0; }
-    int max() const { return P.N - 1; }
+    int max() const { return static_cast<int>(P.N()) - 1; }
     const param_type &param() const { return P; }
     void param(const param_type &P_new) { P = P_new; }
+    // sampling view sharing the alias table
+    view_type view() const { return P.D->T.view(); }
     // probability density function
-    double pdf(int x) const { return (x < 0 or x >= P.N) ? 0.0 : P.P[x]; }
+    double pdf(int x) const { return (x < 0 or x >= static_cast<int>(P.N())) ? 0.0 : P.D->P[x]; }
     // cumulative density function
     double cdf(int x) const {
       if (x < 0)
         return 0.0;
-      if (x < P.N)
-        return std::accumulate(P.P.begin(), P.P.begin() + x + 1, 0.0);
+      if (x < static_cast<int>(P.N()))
+        return std::accumulate(P.D->P.begin(), P.D->P.begin() + x + 1, 0.0);
       return 1.0;
     }
   };  // namespace trng
@@ -157,7 +401,7 @@ namespace trng {
   // EqualityComparable concept
   inline bool operator==(const fast_discrete_dist::param_type &P1,
                          const fast_discrete_dist::param_type &P2) {
-    return P1.P == P2.P;
+    return P1.D == P2.D or P1.D->P == P2.D->P;
   }
   inline bool operator!=(const fast_discrete_dist::param_type &P1,
                          const fast_discrete_dist::param_type &P2) {
@@ -170,10 +414,10 @@ namespace trng {
                                                    const fast_discrete_dist::param_type &P) {
     std::ios_base::fmtflags flags(out.flags());
     out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
-    out << '(' << P.N << ' ';
-    for (std::vector<double>::size_type i = 0; i < P.P.size(); ++i) {
-      out << std::setprecision(math::numeric_limits<double>::digits10 + 1) << P.P[i];
-      if (i + 1 < P.P.size())
+    out << '(' << P.N() << ' ';
+    for (std::vector<double>::size_type i = 0; i < P.N(); ++i) {
+      out << std::setprecision(math::numeric_limits<double>::digits10 + 1) << P.D->P[i];
+      if (i + 1 < P.N())
         out << ' ';
     }
     out << ')';
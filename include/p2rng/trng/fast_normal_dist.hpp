@@ -0,0 +1,85 @@
+// Copyright (c) 2000-2022, Heiko Bauke
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_FAST_NORMAL_DIST_HPP)
+
+#define TRNG_FAST_NORMAL_DIST_HPP
+
+#include <p2rng/trng/normal_dist.hpp>
+#include <p2rng/trng/special_functions.hpp>
+#include <p2rng/trng/utility.hpp>
+#include <cstddef>
+
+namespace trng {
+
+  // normal_dist drawn through the array version of inv_Phi, which auto-vectorizes; its
+  // results agree with normal_dist to within a few ulp but are not bitwise identical, and
+  // they depend on whether the target has the vector instructions the kernel is compiled
+  // for (see math::inv_Phi(const T *, T *, std::size_t)); for host code only, use
+  // normal_dist where the same seed must give the same numbers on all platforms
+  template<typename float_t = double>
+  class fast_normal_dist : public normal_dist<float_t> {
+  public:
+    using result_type = float_t;
+    using param_type = typename normal_dist<float_t>::param_type;
+
+    // constructor
+    explicit fast_normal_dist(result_type mu, result_type sigma)
+        : normal_dist<float_t>{mu, sigma} {}
+    explicit fast_normal_dist(const param_type &P) : normal_dist<float_t>{P} {}
+    // random numbers
+    template<typename R>
+    result_type operator()(R &r) {
+      return icdf(utility::uniformoo<result_type>(r));
+    }
+    template<typename R>
+    result_type operator()(R &r, const param_type &P) {
+      fast_normal_dist g(P);
+      return g(r);
+    }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, result_type>(
+          r, out, n, [](result_type *u, std::size_t m) { math::inv_Phi(u, u, m); },
+          [s = this->sigma(), mu = this->mu()](result_type x) { return x * s + mu; });
+    }
+    // inverse cumulative density function
+    result_type icdf(result_type x) const {
+      math::inv_Phi(&x, &x, 1);
+      return x * this->sigma() + this->mu();
+    }
+  };
+
+}  // namespace trng
+
+#endif
@@ -0,0 +1,307 @@
+// Copyright (c) 2000-2022, Heiko Bauke
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_FAST_UNIFORM_INT_DIST_HPP)
+
+#define TRNG_FAST_UNIFORM_INT_DIST_HPP
+
+#include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
+#include <p2rng/trng/limits.hpp>
+#include <p2rng/trng/utility.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <istream>
+#include <type_traits>
+#include <ciso646>
+
+namespace trng {
+
+  namespace utility {
+
+    // high 64 bits of the 128-bit product x * y
+    P2RNG_DEVICE_CODE inline std::uint64_t mulhi64(std::uint64_t x, std::uint64_t y) {
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+      return __umul64hi(x, y);
+#elif defined(__SIZEOF_INT128__)
+      return static_cast<std::uint64_t>((static_cast<unsigned __int128>(x) * y) >> 64u);
+#else
+      const std::uint64_t x0{x & 0xffffffffu}, x1{x >> 32u};
+      const std::uint64_t y0{y & 0xffffffffu}, y1{y >> 32u};
+      const std::uint64_t p00{x0 * y0}, p01{x0 * y1}, p10{x1 * y0}, p11{x1 * y1};
+      const std::uint64_t mid{(p00 >> 32u) + (p01 & 0xffffffffu) + (p10 & 0xffffffffu)};
+      return p11 + (p01 >> 32u) + (p10 >> 32u) + (mid >> 32u);
+#endif
+    }
+
+  }  // namespace utility
+
+  // uniform integers in [a, b) by multiply-high (Lemire's method without the rejection
+  // step): a raw word w of 32 (for results of up to 32 bits) or 64 bits is mapped to
+  // a + (w * (b - a)) / 2^bits.  The number of engine calls per sample is fixed, one if
+  // the engine yields full 32- or 64-bit words of at least the word size, two for a
+  // 64-bit word from a 32-bit engine.  It is published as draws<R>, which p2rng bind
+  // objects scale discard() by, so block-split parallel generation gives the same
+  // numbers as a serial run; with two calls per sample there is no leapfrog generator.
+  // Without rejection, some results are more likely than others by at most
+  // (b - a) / 2^bits.  Engines without full words (e.g. yarn2) fall back to a word made
+  // of one uniform double in [0, 1).
+  template<typename IntType = int>
+  class fast_uniform_int_dist {
+    static_assert(std::is_integral_v<IntType> and (sizeof(IntType) == 4 or sizeof(IntType) == 8),
+                  "IntType must be a 32- or 64-bit integer type");
+
+  public:
+    using result_type = IntType;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::cheap};
+
+  private:
+    using word_type = std::conditional_t<sizeof(IntType) == 4, std::uint32_t, std::uint64_t>;
+    static constexpr unsigned int word_bits{sizeof(word_type) * 8};
+
+  public:
+    class param_type {
+    private:
+      result_type a_{0}, b_{1};
+      word_type d_{1};
+      P2RNG_DEVICE_CODE
+      word_type d() const { return d_; }
+      P2RNG_DEVICE_CODE
+      void update() { d_ = static_cast<word_type>(b_) - static_cast<word_type>(a_); }
+
+    public:
+      P2RNG_DEVICE_CODE
+      result_type a() const { return a_; }
+      P2RNG_DEVICE_CODE
+      void a(result_type a_new) {
+        a_ = a_new;
+        update();
+      }
+      P2RNG_DEVICE_CODE
+      result_type b() const { return b_; }
+      P2RNG_DEVICE_CODE
+      void b(result_type b_new) {
+        b_ = b_new;
+        update();
+      }
+      param_type() = default;
+      P2RNG_DEVICE_CODE
+      explicit param_type(result_type a, result_type b) : a_(a), b_(b) { update(); }
+
+      friend class fast_uniform_int_dist;
+
+      // EqualityComparable concept
+      P2RNG_DEVICE_CODE
+      friend bool operator==(const param_type &P1, const param_type &P2) {
+        return P1.a() == P2.a() and P1.b() == P2.b();
+      }
+      P2RNG_DEVICE_CODE
+      friend bool operator!=(const param_type &P1, const param_type &P2) {
+        return not(P1 == P2);
+      }
+    };
+
+  private:
+    param_type P;
+
+    // true if R yields full 32- or 64-bit words
+    template<typename R>
+    static constexpr bool full_words =
+        R::min() == 0 and (static_cast<std::uint64_t>(R::max()) == 0xffffffffu or
+                           static_cast<std::uint64_t>(R::max()) == ~std::uint64_t(0));
+
+    template<typename R>
+    static constexpr unsigned int engine_bits =
+        static_cast<std::uint64_t>(R::max()) == 0xffffffffu ? 32 : 64;
+
+  public:
+    // number of calls to r per sample
+    template<typename R>
+    static constexpr std::size_t draws{full_words<R> and engine_bits<R> < word_bits ? 2 : 1};
+
+  private:
+
+    // a raw word from a fixed number of calls to r; the high bits of wider engine outputs
+    template<typename R>
+    P2RNG_DEVICE_CODE static word_type word(R &r) {
+      if constexpr (full_words<R>) {
+        if constexpr (engine_bits<R> >= word_bits)
+          return static_cast<word_type>(static_cast<std::uint64_t>(r()) >>
+                                        (engine_bits<R> - word_bits));
+        else {
+          const word_type hi{static_cast<word_type>(r())};
+          return (hi << 32u) | static_cast<word_type>(r());
+        }
+      } else
+        return static_cast<word_type>(utility::uniformco<double>(r) *
+                                      (static_cast<double>(word_type(1) << (word_bits - 1)) * 2));
+    }
+
+    P2RNG_DEVICE_CODE
+    static result_type map(word_type w, word_type d, result_type a) {
+      word_type x;
+      if constexpr (word_bits == 32)
+        x = static_cast<word_type>((static_cast<std::uint64_t>(w) * d) >> 32u);
+      else
+        x = utility::mulhi64(w, d);
+      return static_cast<result_type>(static_cast<word_type>(a) + x);
+    }
+
+  public:
+    // constructor
+    P2RNG_DEVICE_CODE
+    explicit fast_uniform_int_dist(result_type a, result_type b) : P{a, b} {}
+    P2RNG_DEVICE_CODE
+    explicit fast_uniform_int_dist(const param_type &P) : P{P} {}
+    // reset internal state
+    P2RNG_DEVICE_CODE
+    void reset() {}
+    // random numbers
+    template<typename R>
+    P2RNG_DEVICE_CODE result_type operator()(R &r) {
+      return map(word(r), P.d(), P.a());
+    }
+    template<typename R>
+    P2RNG_DEVICE_CODE result_type operator()(R &r, const param_type &P) {
+      fast_uniform_int_dist g(P);
+      return g(r);
+    }
+    // batch of random numbers, same as n calls to operator()(r); the raw words come in
+    // chunks from the engine's bulk fill() if it has one, so the mapping vectorizes
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      using raw_type = typename R::result_type;
+      if constexpr (full_words<R> and p2rng::has_fill_v<R, raw_type *>) {
+        constexpr std::size_t chunk{256};
+        raw_type raw[chunk * draws<R>];
+        const word_type d{P.d()};
+        const result_type a{P.a()};
+        while (n > 0) {
+          const std::size_t m{n < chunk ? n : chunk};
+          r.fill(raw, m * draws<R>);
+          for (std::size_t i{0}; i < m; ++i, ++out) {
+            word_type w;
+            if constexpr (draws<R> == 1)
+              w = static_cast<word_type>(static_cast<std::uint64_t>(raw[i]) >>
+                                         (engine_bits<R> - word_bits));
+            else
+              w = (static_cast<word_type>(raw[2 * i]) << 32u) |
+                  static_cast<word_type>(raw[2 * i + 1]);
+            *out = map(w, d, a);
+          }
+          n -= m;
+        }
+      } else
+        for (std::size_t i{0}; i < n; ++i, ++out)
+          *out = operator()(r);
+      return out;
+    }
+    // property methods
+    P2RNG_DEVICE_CODE
+    result_type min() const { return P.a(); }
+    P2RNG_DEVICE_CODE
+    result_type max() const { return P.b() - 1; }
+    P2RNG_DEVICE_CODE
+    const param_type &param() const { return P; }
+    P2RNG_DEVICE_CODE
+    void param(const param_type &p_new) { P = p_new; }
+    P2RNG_DEVICE_CODE
+    result_type a() const { return P.a(); }
+    P2RNG_DEVICE_CODE
+    void a(result_type a_new) { P.a(a_new); }
+    P2RNG_DEVICE_CODE
+    result_type b() const { return P.b(); }
+    P2RNG_DEVICE_CODE
+    void b(result_type b_new) { P.b(b_new); }
+    // probability density function
+    P2RNG_DEVICE_CODE
+    double pdf(result_type x) const {
+      if (x < P.a() or x >= P.b())
+        return 0.0;
+      return 1.0 / static_cast<double>(P.d());
+    }
+    // cumulative density function
+    P2RNG_DEVICE_CODE
+    double cdf(result_type x) const {
+      if (x < P.a())
+        return 0;
+      if (x >= P.b())
+        return 1.0;
+      return static_cast<double>(static_cast<word_type>(x) - static_cast<word_type>(P.a()) + 1) /
+             static_cast<double>(P.d());
+    }
+  };
+
+  // -------------------------------------------------------------------
+
+  // EqualityComparable concept
+  template<typename IntType>
+  P2RNG_DEVICE_CODE inline bool operator==(const fast_uniform_int_dist<IntType> &g1,
+                                           const fast_uniform_int_dist<IntType> &g2) {
+    return g1.a() == g2.a() and g1.b() == g2.b();
+  }
+  template<typename IntType>
+  P2RNG_DEVICE_CODE inline bool operator!=(const fast_uniform_int_dist<IntType> &g1,
+                                           const fast_uniform_int_dist<IntType> &g2) {
+    return not(g1 == g2);
+  }
+
+  // Streamable concept
+  template<typename char_t, typename traits_t, typename IntType>
+  std::basic_ostream<char_t, traits_t> &operator<<(std::basic_ostream<char_t, traits_t> &out,
+                                                   const fast_uniform_int_dist<IntType> &g) {
+    std::ios_base::fmtflags flags(out.flags());
+    out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+    out << "[fast_uniform_int (" << g.a() << ' ' << g.b() << ")]";
+    out.flags(flags);
+    return out;
+  }
+
+  template<typename char_t, typename traits_t, typename IntType>
+  std::basic_istream<char_t, traits_t> &operator>>(std::basic_istream<char_t, traits_t> &in,
+                                                   fast_uniform_int_dist<IntType> &g) {
+    IntType a, b;
+    std::ios_base::fmtflags flags(in.flags());
+    in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+    in >> utility::ignore_spaces() >> utility::delim("[fast_uniform_int (") >> a >>
+        utility::delim(' ') >> b >> utility::delim(")]");
+    if (in)
+      g.param(typename fast_uniform_int_dist<IntType>::param_type(a, b));
+    in.flags(flags);
+    return in;
+  }
+
+}  // namespace trng
+
+#endif
@@ -97,6 +97,14 @@ namespace trng {
       geometric_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, double>(
+          r, out, n, [this](double x) {
+            return static_cast<int>(math::ln(x) * P.one_over_ln_q());
+          });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     int min() const { return 0; }
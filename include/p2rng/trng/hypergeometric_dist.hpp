@@ -38,10 +38,13 @@
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/math.hpp>
 #include <p2rng/trng/special_functions.hpp>
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <istream>
 #include <iomanip>
 #include <vector>
+#include <cstdint>
 #include <algorithm>
 #include <ciso646>
 
@@ -59,6 +62,7 @@ namespace trng {
           d_{0},               // number of selected balls
           x_min{0}, x_max{0};  // minimum and maximum values of random variable
       std::vector<double> P_;
+      std::vector<std::uint32_t> G_;  // guide table of P_
 
       void calc_probabilities() {
         x_min = std::max(0, d_ - n_ + m_);
@@ -73,6 +77,7 @@ namespace trng {
           P_[i] += P_[i - 1];
         for (std::vector<double>::size_type i{0}; i < P_.size(); ++i)
           P_[i] /= P_.back();
+        G_ = utility::discrete_guide(P_.begin(), P_.end());
       }
 
     public:
@@ -93,6 +98,23 @@ namespace trng {
       }
       param_type() = default;
       explicit param_type(int n, int m, int d) : n_{n}, m_{m}, d_{d} { calc_probabilities(); }
+      // binary checkpoint (see p2rng::serializer), the parameters only
+      static constexpr std::size_t serialized_size{sizeof(n_) + sizeof(m_) + sizeof(d_)};
+      void serialize(std::byte *out) const {
+        std::memcpy(out, &n_, sizeof(n_));
+        out += sizeof(n_);
+        std::memcpy(out, &m_, sizeof(m_));
+        out += sizeof(m_);
+        std::memcpy(out, &d_, sizeof(d_));
+      }
+      void deserialize(const std::byte *in) {
+        std::memcpy(&n_, in, sizeof(n_));
+        in += sizeof(n_);
+        std::memcpy(&m_, in, sizeof(m_));
+        in += sizeof(m_);
+        std::memcpy(&d_, in, sizeof(d_));
+        calc_probabilities();
+      }
       friend class hypergeometric_dist;
     };
 
@@ -109,13 +131,22 @@ namespace trng {
     template<typename R>
     int operator()(R &r) {
       return P.x_min + static_cast<int>(utility::discrete(utility::uniformoo<double>(r),
-                                                          P.P_.begin(), P.P_.end()));
+                                                          P.P_.begin(), P.P_.end(), P.G_));
     }
     template<typename R>
     int operator()(R &r, const param_type &P) {
       hypergeometric_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, double>(
+          r, out, n, [this](double x) {
+            return P.x_min +
+                   static_cast<int>(utility::discrete(x, P.P_.begin(), P.P_.end(), P.G_));
+          });
+    }
     // property methods
     int min() const { return P.x_min; }
     int max() const { return P.x_max; }
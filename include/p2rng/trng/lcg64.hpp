@@ -0,0 +1,322 @@
+// Copyright (c) 2000-2022, Heiko Bauke
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_LCG64_HPP)
+
+#define TRNG_LCG64_HPP
+
+#include <p2rng/device.hpp>
+#include <p2rng/trng/limits.hpp>
+#include <p2rng/trng/utility.hpp>
+#include <p2rng/trng/int_types.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <ostream>
+#include <istream>
+#include <ciso646>
+
+namespace trng {
+
+  class lcg64 {
+  public:
+    // Uniform random number generator concept
+    using result_type = uint64_t;
+    P2RNG_DEVICE_CODE result_type operator()();
+
+  private:
+    static constexpr result_type min_ = 0;
+    static constexpr result_type max_ = ~result_type(0);
+
+  public:
+    P2RNG_DEVICE_CODE static constexpr result_type min() { return min_; }
+    P2RNG_DEVICE_CODE static constexpr result_type max() { return max_; }
+
+    // Parameter and status classes
+    class parameter_type {
+      result_type a{0}, b{0};
+
+    public:
+      parameter_type() = default;
+      explicit parameter_type(result_type a, result_type b) : a{a}, b{b} {}
+
+      friend class lcg64;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const parameter_type &P1,
+                                                     const parameter_type &P2) {
+        return P1.a == P2.a and P1.b == P2.b;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const parameter_type &P1,
+                                                     const parameter_type &P2) {
+        return not(P1 == P2);
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const parameter_type &P) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << P.a << ' ' << P.b << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, parameter_type &P) {
+        parameter_type P_new;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> P_new.a >> utility::delim(' ') >> P_new.b >>
+            utility::delim(')');
+        if (in)
+          P = P_new;
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    class status_type {
+      result_type r{0};
+
+    public:
+      status_type() = default;
+      explicit status_type(result_type r) : r{r} {}
+
+      friend class lcg64;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const status_type &S1,
+                                                     const status_type &S2) {
+        return S1.r == S2.r;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const status_type &S1,
+                                                     const status_type &S2) {
+        return not(S1 == S2);
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const status_type &S) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << S.r << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, status_type &S) {
+        status_type S_new;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> S_new.r >> utility::delim(')');
+        if (in)
+          S = S_new;
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    inline static const parameter_type Default{18145460002477866997u, 1u};
+    inline static const parameter_type LEcuyer1{2862933555777941757u, 1u};
+    inline static const parameter_type LEcuyer2{3202034522624059733u, 1u};
+    inline static const parameter_type LEcuyer3{3935559000370003845u, 1u};
+
+    // Random number engine concept
+    explicit lcg64(parameter_type P = Default) : P{P} {}
+    explicit lcg64(unsigned long s, parameter_type P = Default) : P{P} { seed(s); }
+    // seeds from the generator g, not a copy constructor nor a seed value
+    template<typename gen,
+             typename = std::enable_if_t<not std::is_arithmetic_v<gen> and
+                                         not std::is_same_v<std::remove_cv_t<gen>, lcg64>>>
+    explicit lcg64(gen &g, parameter_type P = Default) : P{P} {
+      seed(g);
+    }
+
+    void seed() { (*this) = lcg64(); }
+    void seed(unsigned long s) { S.r = s; }
+    template<typename gen, typename = std::enable_if_t<not std::is_arithmetic_v<gen>>>
+    void seed(gen &g) {
+      result_type r{0};
+      for (int i{0}; i < 2; ++i) {
+        r <<= 32;
+        r += g();
+      }
+      S.r = r;
+    }
+
+    P2RNG_DEVICE_CODE void discard(unsigned long long n) { jump(n); }
+
+    // Equality comparable concept
+    friend P2RNG_DEVICE_CODE inline bool operator==(const lcg64 &R1, const lcg64 &R2) {
+      return R1.P == R2.P and R1.S == R2.S;
+    }
+
+    friend P2RNG_DEVICE_CODE inline bool operator!=(const lcg64 &R1, const lcg64 &R2) {
+      return not(R1 == R2);
+    }
+
+    // Streamable concept
+    template<typename char_t, typename traits_t>
+    friend std::basic_ostream<char_t, traits_t> &operator<<(
+        std::basic_ostream<char_t, traits_t> &out, const lcg64 &R) {
+      std::ios_base::fmtflags flags(out.flags());
+      out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      out << '[' << lcg64::name() << ' ' << R.P << ' ' << R.S << ']';
+      out.flags(flags);
+      return out;
+    }
+
+    template<typename char_t, typename traits_t>
+    friend std::basic_istream<char_t, traits_t> &operator>>(
+        std::basic_istream<char_t, traits_t> &in, lcg64 &R) {
+      lcg64::parameter_type P_new;
+      lcg64::status_type S_new;
+      std::ios_base::fmtflags flags(in.flags());
+      in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      in >> utility::ignore_spaces();
+      in >> utility::delim('[') >> utility::delim(lcg64::name()) >> utility::delim(' ') >>
+          P_new >> utility::delim(' ') >> S_new >> utility::delim(']');
+      if (in) {
+        R.P = P_new;
+        R.S = S_new;
+      }
+      in.flags(flags);
+      return in;
+    }
+
+    // Parallel random number generator concept
+    void split(unsigned int s, unsigned int n) {
+      if (s < 1 or n >= s)
+        utility::throw_this(std::invalid_argument("invalid argument for trng::lcg64::split"));
+      if (s > 1) {
+        jump(n + 1);
+        P.b *= f(s, P.a);
+        P.a = pow(P.a, s);
+        backward();
+      }
+    }
+
+    // a copy of this engine that yields every s-th number from here on
+    lcg64 leapfrog(unsigned int s) const {
+      lcg64 r{*this};
+      r.split(s, 0);
+      return r;
+    }
+
+    P2RNG_DEVICE_CODE void jump2(unsigned int s) {
+      result_type a{P.a}, b{P.b};
+      for (unsigned int i{0}; i < s; ++i) {
+        b *= a + 1u;
+        a *= a;
+      }
+      S.r = a * S.r + b;
+    }
+
+    P2RNG_DEVICE_CODE void jump(unsigned long long s) {
+      if (s < 16) {
+        for (unsigned int i{0}; i < s; ++i)
+          step();
+      } else {
+        unsigned int i{0};
+        while (s > 0) {
+          if (s % 2 == 1)
+            jump2(i);
+          ++i;
+          s >>= 1;
+        }
+      }
+    }
+
+    // Other useful methods
+    static const char *name() { return "lcg64"; }
+    long operator()(long x) {
+      return static_cast<long>(utility::uniformco<double, lcg64>(*this) * x);
+    }
+
+  private:
+    parameter_type P;
+    status_type S;
+
+    // a^n modulo 2^64
+    static result_type pow(result_type a, unsigned long long n) {
+      result_type result{1};
+      while (n > 0) {
+        if ((n & 1u) > 0)
+          result *= a;
+        a *= a;
+        n >>= 1;
+      }
+      return result;
+    }
+
+    // 1 + a + a^2 + ... + a^(s-1) modulo 2^64, blocks of 2^i terms for the set bits of s
+    static result_type f(unsigned long long s, result_type a) {
+      result_type sum{0}, a_offset{1};
+      result_type block{1}, a_block{a};  // 1 + ... + a^(2^i-1) and a^(2^i)
+      while (s > 0) {
+        if ((s & 1u) > 0) {
+          sum += a_offset * block;
+          a_offset *= a_block;
+        }
+        block *= a_block + 1u;
+        a_block *= a_block;
+        s >>= 1;
+      }
+      return sum;
+    }
+
+    // one step back, the multiplier is odd and thus invertible modulo 2^64
+    P2RNG_DEVICE_CODE void backward() {
+      result_type a_inv{P.a};
+      for (int i{0}; i < 5; ++i)
+        a_inv *= 2u - P.a * a_inv;
+      S.r = (S.r - P.b) * a_inv;
+    }
+
+    P2RNG_DEVICE_CODE void step() { S.r = P.a * S.r + P.b; }
+  };
+
+  P2RNG_DEVICE_CODE inline lcg64::result_type lcg64::operator()() {
+    step();
+    return S.r;
+  }
+
+}  // namespace trng
+
+#endif
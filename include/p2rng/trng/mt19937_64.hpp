@@ -0,0 +1,285 @@
+// Copyright (c) 2000-2022, Heiko Bauke
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_MT19937_64_HPP)
+
+#define TRNG_MT19937_64_HPP
+
+#include <p2rng/device.hpp>
+#include <p2rng/trng/limits.hpp>
+#include <p2rng/trng/utility.hpp>
+#include <p2rng/trng/int_types.hpp>
+#include <type_traits>
+#include <ostream>
+#include <istream>
+#include <ciso646>
+
+namespace trng {
+
+  // 64-bit Mersenne twister of Matsumoto and Nishimura, the same sequence as
+  // std::mt19937_64; it can't jump ahead, discard() steps
+  class mt19937_64 {
+  public:
+    // Uniform random number generator concept
+    using result_type = uint64_t;
+    P2RNG_DEVICE_CODE result_type operator()();
+
+  private:
+    static constexpr result_type min_ = 0;
+    static constexpr result_type max_ = ~result_type(0);
+
+  public:
+    P2RNG_DEVICE_CODE static constexpr result_type min() { return min_; }
+    P2RNG_DEVICE_CODE static constexpr result_type max() { return max_; }
+
+    static constexpr int N = 312;
+    static constexpr int M = 156;
+
+  private:
+    static constexpr result_type UM = 0xffffffff80000000u;  // most significant 33 bits
+    static constexpr result_type LM = 0x7fffffffu;          // least significant 31 bits
+
+  public:
+    // Parameter and status classes
+    class parameter_type {
+    public:
+      parameter_type() = default;
+
+      friend class mt19937_64;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const parameter_type &,
+                                                     const parameter_type &) {
+        return true;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const parameter_type &,
+                                                     const parameter_type &) {
+        return false;
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const parameter_type &) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, parameter_type &) {
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> utility::delim(')');
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    class status_type {
+      result_type mt[N]{};
+      int mti{N + 1};
+
+    public:
+      status_type() = default;
+
+      friend class mt19937_64;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const status_type &S1,
+                                                     const status_type &S2) {
+        if (S1.mti != S2.mti)
+          return false;
+        for (int i{0}; i < N; ++i)
+          if (S1.mt[i] != S2.mt[i])
+            return false;
+        return true;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const status_type &S1,
+                                                     const status_type &S2) {
+        return not(S1 == S2);
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const status_type &S) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << S.mti << ' ' << utility::make_io_range(S.mt, S.mt + N, " ") << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, status_type &S) {
+        status_type S_new;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> S_new.mti >> utility::delim(' ') >>
+            utility::make_io_range(S_new.mt, S_new.mt + N, " ") >> utility::delim(')');
+        if (in)
+          S = S_new;
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    // Random number engine concept
+    mt19937_64() { seed(); }
+    explicit mt19937_64(unsigned long s) { seed(s); }
+    // seeds from the generator g, not a copy constructor nor a seed value
+    template<typename gen,
+             typename = std::enable_if_t<not std::is_arithmetic_v<gen> and
+                                         not std::is_same_v<std::remove_cv_t<gen>, mt19937_64>>>
+    explicit mt19937_64(gen &g) {
+      seed(g);
+    }
+
+    void seed() { seed(5489u); }
+    void seed(unsigned long s) {
+      S.mt[0] = s;
+      for (S.mti = 1; S.mti < N; ++S.mti)
+        S.mt[S.mti] = 6364136223846793005u * (S.mt[S.mti - 1] ^ (S.mt[S.mti - 1] >> 62)) +
+                      static_cast<result_type>(S.mti);
+    }
+    template<typename gen, typename = std::enable_if_t<not std::is_arithmetic_v<gen>>>
+    void seed(gen &g) {
+      for (int i{0}; i < N; ++i) {
+        result_type r{0};
+        for (int j{0}; j < 2; ++j) {
+          r <<= 32;
+          r += g();
+        }
+        S.mt[i] = r;
+      }
+      S.mti = N;
+    }
+
+    P2RNG_DEVICE_CODE void discard(unsigned long long n) {
+      for (unsigned long long i{0}; i < n; ++i)
+        step();
+    }
+
+    // Equality comparable concept
+    friend P2RNG_DEVICE_CODE inline bool operator==(const mt19937_64 &R1,
+                                                   const mt19937_64 &R2) {
+      return R1.P == R2.P and R1.S == R2.S;
+    }
+
+    friend P2RNG_DEVICE_CODE inline bool operator!=(const mt19937_64 &R1,
+                                                   const mt19937_64 &R2) {
+      return not(R1 == R2);
+    }
+
+    // Streamable concept
+    template<typename char_t, typename traits_t>
+    friend std::basic_ostream<char_t, traits_t> &operator<<(
+        std::basic_ostream<char_t, traits_t> &out, const mt19937_64 &R) {
+      std::ios_base::fmtflags flags(out.flags());
+      out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      out << '[' << mt19937_64::name() << ' ' << R.P << ' ' << R.S << ']';
+      out.flags(flags);
+      return out;
+    }
+
+    template<typename char_t, typename traits_t>
+    friend std::basic_istream<char_t, traits_t> &operator>>(
+        std::basic_istream<char_t, traits_t> &in, mt19937_64 &R) {
+      mt19937_64::parameter_type P_new;
+      mt19937_64::status_type S_new;
+      std::ios_base::fmtflags flags(in.flags());
+      in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      in >> utility::ignore_spaces();
+      in >> utility::delim('[') >> utility::delim(mt19937_64::name()) >>
+          utility::delim(' ') >> P_new >> utility::delim(' ') >> S_new >> utility::delim(']');
+      if (in) {
+        R.P = P_new;
+        R.S = S_new;
+      }
+      in.flags(flags);
+      return in;
+    }
+
+    // Other useful methods
+    static const char *name() { return "mt19937_64"; }
+    long operator()(long x) {
+      return static_cast<long>(utility::uniformco<double, mt19937_64>(*this) * x);
+    }
+
+  private:
+    parameter_type P;
+    status_type S;
+
+    // regenerates the whole state once it is used up
+    P2RNG_DEVICE_CODE void reload() {
+      int i{0};
+      for (; i < N - M; ++i) {
+        const result_type x{(S.mt[i] & UM) | (S.mt[i + 1] & LM)};
+        S.mt[i] = S.mt[i + M] ^ (x >> 1) ^ ((x & 1u) * 0xb5026f5aa96619e9u);
+      }
+      for (; i < N - 1; ++i) {
+        const result_type x{(S.mt[i] & UM) | (S.mt[i + 1] & LM)};
+        S.mt[i] = S.mt[i + (M - N)] ^ (x >> 1) ^ ((x & 1u) * 0xb5026f5aa96619e9u);
+      }
+      const result_type x{(S.mt[N - 1] & UM) | (S.mt[0] & LM)};
+      S.mt[N - 1] = S.mt[M - 1] ^ (x >> 1) ^ ((x & 1u) * 0xb5026f5aa96619e9u);
+      S.mti = 0;
+    }
+
+    P2RNG_DEVICE_CODE void step() {
+      if (S.mti >= N)
+        reload();
+      ++S.mti;
+    }
+  };
+
+  P2RNG_DEVICE_CODE inline mt19937_64::result_type mt19937_64::operator()() {
+    if (S.mti >= N)
+      reload();
+    result_type x{S.mt[S.mti++]};
+    x ^= (x >> 29) & 0x5555555555555555u;
+    x ^= (x << 17) & 0x71d67fffeda60000u;
+    x ^= (x << 37) & 0xfff7eee000000000u;
+    x ^= (x >> 43);
+    return x;
+  }
+
+}  // namespace trng
+
+#endif
@@ -39,10 +39,12 @@
 #include <p2rng/trng/math.hpp>
 #include <p2rng/trng/special_functions.hpp>
 #include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <istream>
 #include <iomanip>
 #include <vector>
+#include <cstdint>
 #include <algorithm>
 #include <numeric>
 #include <ciso646>
@@ -59,6 +61,7 @@ namespace trng {
       double p_{0};
       double r_{0};
       std::vector<double> P_;
+      std::vector<std::uint32_t> G_;  // guide table of P_
 
       // probability density function
       double pdf(int x) const {
@@ -89,6 +92,7 @@ namespace trng {
           ++x;
         }
         P_.push_back(1);
+        G_ = utility::discrete_guide(P_.begin(), P_.end());
       }
 
     public:
@@ -104,23 +108,27 @@ namespace trng {
       }
       param_type() = default;
       explicit param_type(double p, double r) : p_{p}, r_{r} { calc_probabilities(); }
+      // binary checkpoint (see p2rng::serializer), the parameters only
+      static constexpr std::size_t serialized_size{sizeof(p_) + sizeof(r_)};
+      void serialize(std::byte *out) const {
+        std::memcpy(out, &p_, sizeof(p_));
+        out += sizeof(p_);
+        std::memcpy(out, &r_, sizeof(r_));
+      }
+      void deserialize(const std::byte *in) {
+        std::memcpy(&p_, in, sizeof(p_));
+        in += sizeof(p_);
+        std::memcpy(&r_, in, sizeof(r_));
+        calc_probabilities();
+      }
       friend class negative_binomial_dist;
     };
 
   private:
     param_type P;
 
-  public:
-    // constructor
-    explicit negative_binomial_dist(double p, double r) : P{p, r} {}
-    explicit negative_binomial_dist(const param_type &P) : P{P} {}
-    // reset internal state
-    void reset() {}
-    // random numbers
-    template<typename R>
-    int operator()(R &r) {
-      double p{utility::uniformco<double>(r)};
-      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end())};
+    int icdf_(double p) const {
+      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end(), P.G_)};
       int x_i{static_cast<int>(x)};
       if (x + 1 == P.P_.size()) {
         p -= cdf(x_i);
@@ -131,11 +139,29 @@ namespace trng {
       }
       return x_i;
     }
+
+  public:
+    // constructor
+    explicit negative_binomial_dist(double p, double r) : P{p, r} {}
+    explicit negative_binomial_dist(const param_type &P) : P{P} {}
+    // reset internal state
+    void reset() {}
+    // random numbers
+    template<typename R>
+    int operator()(R &r) {
+      return icdf_(utility::uniformco<double>(r));
+    }
     template<typename R>
     int operator()(R &r, const param_type &p) {
       negative_binomial_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [this](double x) { return icdf_(x); });
+    }
     // property methods
     int min() const { return 0; }
     int max() const { return math::numeric_limits<int>::max(); }
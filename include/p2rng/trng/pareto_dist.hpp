@@ -133,6 +133,14 @@ namespace trng {
       pareto_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oo, result_type>(
+          r, out, n, [this](result_type x) {
+            return (math::pow(x, -1 / P.gamma()) - 1) * P.theta();
+          });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     result_type min() const { return 0; }
@@ -39,10 +39,13 @@
 #include <p2rng/trng/math.hpp>
 #include <p2rng/trng/special_functions.hpp>
 #include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <istream>
 #include <iomanip>
 #include <vector>
+#include <cstdint>
+#include <memory>
 #include <ciso646>
 
 namespace trng {
@@ -55,16 +58,38 @@ namespace trng {
     class param_type {
     private:
       double mu_{0};
+      // cumulative density function up to where it rounds to 1, with its guide table, for
+      // mu < window_mu, ...
       std::vector<double> P_;
+      std::vector<std::uint32_t> G_;
+      // ... or its window, shared by all copies
+      std::shared_ptr<const utility::cdf_window> W_;
 
+      // the table is built from the incomplete gamma function, whose continued fraction loses
+      // accuracy as mu grows (its CDF is off by 2e-2 at mu = 1000), so unlike binomial_dist
+      // the window takes over well below cdf_window::full_size values; it samples as fast
+      static constexpr double window_mu{2048};
+
+      double up(int x) const { return mu_ / (x + 1.0); }
+      double down(int x) const { return x / mu_; }
       void calc_probabilities() {
         P_ = std::vector<double>();
+        G_ = std::vector<std::uint32_t>();
+        W_.reset();
+        if (mu_ >= window_mu) {
+          W_ = std::make_shared<const utility::cdf_window>(
+              static_cast<int>(mu_), math::numeric_limits<int>::max(),
+              [this](int x) { return up(x); }, [this](int x) { return down(x); });
+          return;
+        }
         int x = 0;
-        while (x < 7 or x < 2 * mu_) {
+        while (x < 7 or x < 2 * mu_ or P_.back() < 1.0) {
           P_.push_back(math::GammaQ(x + 1.0, mu_));
           ++x;
         }
         P_.push_back(1);
+        G_ = utility::discrete_guide(P_.begin(), P_.end(),
+                                     utility::cdf_window::guide_scale * P_.size());
       }
 
     public:
@@ -73,25 +98,28 @@ namespace trng {
         mu_ = mu_new;
         calc_probabilities();
       }
-      param_type() = default;
+      param_type() { calc_probabilities(); }
       explicit param_type(double mu) : mu_{mu} { calc_probabilities(); }
+      // binary checkpoint (see p2rng::serializer), the parameters only
+      static constexpr std::size_t serialized_size{sizeof(mu_)};
+      void serialize(std::byte *out) const {
+        std::memcpy(out, &mu_, sizeof(mu_));
+      }
+      void deserialize(const std::byte *in) {
+        std::memcpy(&mu_, in, sizeof(mu_));
+        calc_probabilities();
+      }
       friend class poisson_dist;
     };
 
   private:
     param_type P;
 
-  public:
-    // constructor
-    explicit poisson_dist(double mu) : P{mu} {}
-    explicit poisson_dist(const param_type &P) : P{P} {}
-    // reset internal state
-    void reset() {}
-    // random numbers
-    template<typename R>
-    int operator()(R &r) {
-      double p{utility::uniformco<double>(r)};
-      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end())};
+    int icdf_(double p) const {
+      if (P.W_)
+        return P.W_->icdf(p, [this](int x) { return P.up(x); },
+                          [this](int x) { return P.down(x); });
+      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end(), P.G_)};
       int x_i{static_cast<int>(x)};
       if (x + 1 == P.P_.size()) {
         p -= cdf(x_i);
@@ -102,11 +130,29 @@ namespace trng {
       }
       return x_i;
     }
+
+  public:
+    // constructor
+    explicit poisson_dist(double mu) : P{mu} {}
+    explicit poisson_dist(const param_type &P) : P{P} {}
+    // reset internal state
+    void reset() {}
+    // random numbers
+    template<typename R>
+    int operator()(R &r) {
+      return icdf_(utility::uniformco<double>(r));
+    }
     template<typename R>
     int operator()(R &r, const param_type &p) {
       poisson_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [this](double x) { return icdf_(x); });
+    }
     // property methods
     int min() const { return 0; }
     int max() const { return math::numeric_limits<int>::max(); }
@@ -35,6 +35,7 @@
 #define TRNG_SNEDECOR_F_DIST_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/math.hpp>
@@ -52,6 +53,8 @@ namespace trng {
   class snedecor_f_dist {
   public:
     using result_type = float_t;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::expensive};
 
     class param_type {
     private:
@@ -138,6 +141,12 @@ namespace trng {
       snedecor_f_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, result_type>(
+          r, out, n, [this](result_type x) { return icdf_(x); });
+    }
     // property methods
     result_type min() const { return 0; }
     P2RNG_DEVICE_CODE
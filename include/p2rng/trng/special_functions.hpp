@@ -40,6 +40,9 @@
 #include <p2rng/trng/constants.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include <ciso646>
 
@@ -765,6 +768,197 @@ namespace trng {
     inline long double inv_Phi(long double x) { return detail::inv_Phi<long double>(x); }
 #endif
 
+    // --- inverse of normal distribution function, array version  ----
+
+    // Branch-free kernel for whole arrays.  It is based on algorithm AS 241 by M. J. Wichura
+    // (Applied Statistics, Vol. 37, No. 3 (1988), pp. 477-484), which is accurate to about
+    // 1e-16 without the Halley refinement step and thus does not need Phi.  All regions are
+    // evaluated for every element and combined by bitwise selection, logarithm and square
+    // root are computed by polynomial and Newton iterations, such that compilers can
+    // vectorize the loop without fast-math flags (e.g., with SSE4.2, AVX2 or AVX-512).
+    // Results agree with the scalar inv_Phi to within a few ulp, but are in general not
+    // bitwise identical, nor are they on targets where the scalar loop below is taken;
+    // therefore normal_dist and its relatives keep the scalar version and only the opt-in
+    // fast_normal_dist uses this one.  Unlike the scalar version, errno is not set.
+
+    namespace detail {
+
+      inline double vec_select(bool c, double a, double b) {
+        std::uint64_t ua, ub;
+        std::memcpy(&ua, &a, sizeof(ua));
+        std::memcpy(&ub, &b, sizeof(ub));
+        const std::uint64_t m{-static_cast<std::uint64_t>(c)};
+        ua = (ua & m) | (ub & ~m);
+        std::memcpy(&a, &ua, sizeof(a));
+        return a;
+      }
+
+      // natural logarithm for positive normal numbers, method as in fdlibm's log
+      inline double vec_ln(double x) {
+        std::uint64_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        // shift mantissa range to [sqrt(1/2), sqrt(2)), k is computed via the
+        // 2^52 + k trick, the int64 to double conversion would not vectorize
+        u += 0x3ff0000000000000ull - 0x3fe6a09e667f3bcdull;
+        const std::uint64_t ub_k{(u >> 52) | 0x4330000000000000ull};
+        const std::uint64_t ub_m{(u & 0x000fffffffffffffull) + 0x3fe6a09e667f3bcdull};
+        double k, m;
+        std::memcpy(&k, &ub_k, sizeof(k));
+        std::memcpy(&m, &ub_m, sizeof(m));
+        k -= 4503599627370496.0 + 1023.0;
+        const double f{m - 1}, s{f / (2 + f)}, z{s * s}, w{z * z};
+        const double t1{w * (3.999999999940941908e-01 +
+                             w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01))};
+        const double t2{z * (6.666666666666735130e-01 +
+                             w * (2.857142874366239149e-01 +
+                                  w * (1.818357216161805012e-01 + w * 1.479819860511658591e-01)))};
+        const double R{t2 + t1}, hfsq{0.5 * f * f};
+        return k * 6.93147180369123816490e-01 -
+               ((hfsq - (s * (hfsq + R) + k * 1.90821492927058770002e-10)) - f);
+      }
+
+      // square root for positive normal numbers, std::sqrt does not vectorize as long as
+      // it may set errno
+      inline double vec_sqrt(double x) {
+        std::uint64_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        u = 0x5fe6eb50c7b537a9ull - (u >> 1);
+        double y;
+        std::memcpy(&y, &u, sizeof(y));
+        const double h{0.5 * x};
+        // Newton iterations for 1/sqrt(x), then a final correction for sqrt(x)
+        y *= 1.5 - h * y * y;
+        y *= 1.5 - h * y * y;
+        y *= 1.5 - h * y * y;
+        y *= 1.5 - h * y * y;
+        const double r{x * y};
+        return r + 0.5 * y * (x - r * r);
+      }
+
+      // the whole computation is written out in the loop body, a per-element function would
+      // be too large for being inlined; float arguments are processed in double precision
+      template<typename T>
+      void inv_Phi(const T *x_, T *y_, std::size_t n) {
+        for (std::size_t i{0}; i < n; ++i) {
+          const double x{x_[i]};
+          // central region, |x - 1/2| <= 0.425
+          const double q{x - 0.5};
+          const double r{0.180625 - q * q};
+          const double n_c{
+              q * (((((((2.5090809287301226727e+3 * r + 3.3430575583588128105e+4) * r +
+                        6.7265770927008700853e+4) *
+                           r +
+                       4.5921953931549871457e+4) *
+                          r +
+                      1.3731693765509461125e+4) *
+                         r +
+                     1.9715909503065514427e+3) *
+                        r +
+                    1.3314166789178437745e+2) *
+                       r +
+                   3.3871328727963666080e+0)};
+          const double d_c{(((((((5.2264952788528545610e+3 * r + 2.8729085735721942674e+4) * r +
+                                 3.9307895800092710610e+4) *
+                                    r +
+                                2.1213794301586595867e+4) *
+                                   r +
+                               5.3941960214247511077e+3) *
+                                  r +
+                              6.8718700749205790830e+2) *
+                                 r +
+                             4.2313330701600911252e+1) *
+                                r +
+                            1)};
+          // tails, 1 - x is exact for x >= 1/2
+          const double t{vec_sqrt(-vec_ln(vec_select(q < 0, x, 1 - x)))};
+          const double s{t - 1.6};
+          const double n_m{(((((((7.74545014278341407640e-4 * s + 2.27238449892691845833e-2) * s +
+                                 2.41780725177450611770e-1) *
+                                    s +
+                                1.27045825245236838258e+0) *
+                                   s +
+                               3.64784832476320460504e+0) *
+                                  s +
+                              5.76949722146069140550e+0) *
+                                 s +
+                             4.63033784615654529590e+0) *
+                                s +
+                            1.42343711074968357734e+0)};
+          const double d_m{(((((((1.05075007164441684324e-9 * s + 5.47593808499534494600e-4) * s +
+                                 1.51986665636164571966e-2) *
+                                    s +
+                                1.48103976427480074590e-1) *
+                                   s +
+                               6.89767334985100004550e-1) *
+                                  s +
+                              1.67638483018380384940e+0) *
+                                 s +
+                             2.05319162663775882187e+0) *
+                                s +
+                            1)};
+          const double v{t - 5};
+          const double n_t{(((((((2.01033439929228813265e-7 * v + 2.71155556874348757815e-5) * v +
+                                 1.24266094738807843860e-3) *
+                                    v +
+                                2.65321895265761230930e-2) *
+                                   v +
+                               2.96560571828504891230e-1) *
+                                  v +
+                              1.78482653991729133580e+0) *
+                                 v +
+                             5.46378491116411436990e+0) *
+                                v +
+                            6.65790464350110377720e+0)};
+          const double d_t{(((((((2.04426310338993978564e-15 * v + 1.42151175831644588870e-7) * v +
+                                 1.84631831751005468180e-5) *
+                                    v +
+                                7.86869131145613259100e-4) *
+                                   v +
+                               1.48753612908506148525e-2) *
+                                  v +
+                              1.36929880922735805310e-1) *
+                                 v +
+                             5.99832206555887937690e-1) *
+                                v +
+                            1)};
+          const bool central{abs(q) <= 0.425}, mid{t <= 5};
+          const double n_a{vec_select(mid, n_m, n_t)}, d_a{vec_select(mid, d_m, d_t)};
+          const double y{vec_select(central, n_c, vec_select(q < 0, -n_a, n_a)) /
+                         vec_select(central, d_c, d_a)};
+          // special values
+          y_[i] = static_cast<T>(vec_select(
+              (x > 0) & (x < 1), y,
+              vec_select(x == 0, -numeric_limits<double>::infinity(),
+                         vec_select(x == 1, numeric_limits<double>::infinity(),
+                                    numeric_limits<double>::quiet_NaN()))));
+        }
+      }
+
+    }  // namespace detail
+
+    // y[i] = inv_Phi(x[i]) for i = 0, ..., n - 1, x and y may be the same array
+    // without 64-bit integer vector compares (e.g. plain SSE2) the kernel is not
+    // vectorized and the scalar version is faster
+#if defined __SSE4_2__ or defined __AVX__ or defined __ARM_NEON or defined __aarch64__
+    inline void inv_Phi(const float *x, float *y, std::size_t n) {
+      detail::inv_Phi<float>(x, y, n);
+    }
+
+    inline void inv_Phi(const double *x, double *y, std::size_t n) {
+      detail::inv_Phi<double>(x, y, n);
+    }
+#else
+    inline void inv_Phi(const float *x, float *y, std::size_t n) {
+      for (std::size_t i{0}; i < n; ++i)
+        y[i] = inv_Phi(x[i]);
+    }
+
+    inline void inv_Phi(const double *x, double *y, std::size_t n) {
+      for (std::size_t i{0}; i < n; ++i)
+        y[i] = inv_Phi(x[i]);
+    }
+#endif
+
     // --- inverse of error function  ----------------------------------
 
     P2RNG_DEVICE_CODE
@@ -35,6 +35,7 @@
 #define TRNG_UNIFORM01_DIST_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <ostream>
@@ -49,6 +50,8 @@ namespace trng {
   class uniform01_dist {
   public:
     using result_type = float_t;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::cheap};
 
     class param_type {
     public:
@@ -107,6 +110,12 @@ namespace trng {
     P2RNG_DEVICE_CODE result_type operator()(R &r, const param_type &) {
       return utility::uniformco<result_type>(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, result_type>(
+          r, out, n, [](result_type x) { return x; });
+    }
     // property methods
     // min / max
     P2RNG_DEVICE_CODE
@@ -35,6 +35,7 @@
 #define TRNG_UNIFORM_DIST_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <ostream>
@@ -50,6 +51,8 @@ namespace trng {
   class uniform_dist {
   public:
     using result_type = float_t;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::cheap};
 
     class param_type {
     private:
@@ -137,6 +140,12 @@ namespace trng {
       uniform_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, result_type>(
+          r, out, n, [d = P.d(), a = P.a()](result_type x) { return d * x + a; });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     result_type min() const { return P.a(); }
@@ -35,6 +35,7 @@
 #define TRNG_UNIFORM_INT_DIST_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <p2rng/trng/utility.hpp>
 #include <ostream>
@@ -47,6 +48,8 @@ namespace trng {
   class uniform_int_dist {
   public:
     using result_type = int;
+    // cost of one sample, used by p2rng to size the thread team
+    static constexpr p2rng::cost_class sample_cost{p2rng::cost_class::cheap};
 
     class param_type {
     private:
@@ -98,6 +101,14 @@ namespace trng {
       uniform_int_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [d = P.d(), a = P.a()](double x) {
+            return static_cast<result_type>(d * x) + a;
+          });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     result_type min() const { return P.a(); }
@@ -35,6 +35,7 @@
 #define TRNG_UNIFORMXX_HPP
 
 #include <p2rng/device.hpp>
+#include <p2rng/traits.hpp>
 #include <p2rng/trng/limits.hpp>
 #include <cstddef>
 #include <cfloat>
@@ -146,8 +147,10 @@ namespace trng {
           use_ll_of_shifted ? (domain_max0 >> 1u) : domain_max0;
 
       P2RNG_DEVICE_CODE
-      static ret_t addin(prng_t &r) {
-        const result_type x{r() - prng_t::min()};
+      static ret_t addin(prng_t &r) { return addin(r()); }
+      P2RNG_DEVICE_CODE
+      static ret_t addin(const result_type x0) {
+        const result_type x{x0 - prng_t::min()};
         if (int_ok)
           return static_cast<ret_t>(static_cast<int>(x));
         else if (long_ok)
@@ -159,6 +162,14 @@ namespace trng {
         else
           return static_cast<ret_t>(x);
       }
+      // same value as addin(x0), but values of up to 32 bits go through an (exact)
+      // conversion to double, which unlike the conversion from long vectorizes
+      static ret_t addin_bulk(const result_type x0) {
+        if constexpr (domain_bits <= 32)
+          return static_cast<ret_t>(static_cast<double>(x0 - prng_t::min()));
+        else
+          return addin(x0);
+      }
       P2RNG_DEVICE_CODE
       static ret_t variate_max() {
         const ret_t scale_per_step{static_cast<ret_t>(domain_max) + 1};
@@ -184,6 +195,31 @@ namespace trng {
           ret = ret * scale_per_step + addin(r);
         return ret;
       }
+      // bulk version of variate(), draws calls_needed * n values from r (in one go if r
+      // provides a bulk fill() member), combines them exactly as n calls to variate(r)
+      // would and stores map(variate) to out
+      template<typename Map>
+      static void variate(prng_t &r, ret_t *out, std::size_t n, Map map) {
+        constexpr std::size_t chunk{256};
+        result_type raw[chunk * calls_needed];
+        const ret_t scale_per_step(ret_t(domain_max) + 1);
+        while (n > 0) {
+          const std::size_t m{n < chunk ? n : chunk};
+          if constexpr (p2rng::has_fill_v<prng_t, result_type *>)
+            r.fill(raw, m * calls_needed);
+          else
+            for (std::size_t i{0}; i < m * calls_needed; ++i)
+              raw[i] = r();
+          for (std::size_t i{0}; i < m; ++i) {
+            ret_t ret{addin_bulk(raw[i * calls_needed])};
+            for (std::size_t j{1}; j < calls_needed; ++j)
+              ret = ret * scale_per_step + addin_bulk(raw[i * calls_needed + j]);
+            out[i] = map(ret);
+          }
+          out += m;
+          n -= m;
+        }
+      }
       P2RNG_DEVICE_CODE
       static ret_t eps() {
 #if defined __CUDA_ARCH__
@@ -214,6 +250,23 @@ namespace trng {
       static return_type oc(prng_t &r) { return ret_t(1) - co(r); }
       P2RNG_DEVICE_CODE
       static return_type oo(prng_t &r) { return variate(r) * oo_norm() + eps(); }
+      // bulk versions, same as n calls to the functions above
+      static void cc(prng_t &r, return_type *out, std::size_t n) {
+        const ret_t vmax{variate_max()}, norm{cc_norm()};
+        if (vmax * norm != 1)
+          variate(r, out, n, [vmax](ret_t x) { return x / vmax; });
+        else
+          variate(r, out, n, [norm](ret_t x) { return x * norm; });
+      }
+      static void co(prng_t &r, return_type *out, std::size_t n) {
+        variate(r, out, n, [norm = co_norm()](ret_t x) { return x * norm; });
+      }
+      static void oc(prng_t &r, return_type *out, std::size_t n) {
+        variate(r, out, n, [norm = co_norm()](ret_t x) { return ret_t(1) - x * norm; });
+      }
+      static void oo(prng_t &r, return_type *out, std::size_t n) {
+        variate(r, out, n, [norm = oo_norm(), e = eps()](ret_t x) { return x * norm + e; });
+      }
     };
 
     template<typename ReturnType, std::size_t bits, typename UniformRandomNumberGenerator>
@@ -241,6 +294,50 @@ namespace trng {
       return u01xx_traits<ReturnType, 1, PrngType>::oo(r);
     }
 
+    //------------------------------------------------------------------
+
+    // the four kinds of uniform variates above, selects the bulk generator used by
+    // batch_generate()
+    enum class u01_kind { cc, co, oc, oo };
+
+    // Batch sampling: draws n uniform variates of the given kind in bulk and writes
+    // f(u) for each of them to out.  The uniforms are consumed in the same order as n
+    // calls to uniformxx<ReturnType>(r), thus the result is the same as n calls to the
+    // distribution's operator(), but the transformation runs in a tight loop that can
+    // be vectorized.  The optional kernel k(u, m) transforms each chunk of m uniforms
+    // in place before f is applied, for array versions of special functions.
+    template<u01_kind kind, typename ReturnType, typename PrngType, typename OutputIter,
+             typename Kernel, typename Transform>
+    OutputIter batch_generate(PrngType &r, OutputIter out, std::size_t n, Kernel k,
+                              Transform f) {
+      using traits = u01xx_traits<ReturnType, 1, PrngType>;
+      constexpr std::size_t chunk{256};
+      ReturnType u[chunk];
+      while (n > 0) {
+        const std::size_t m{n < chunk ? n : chunk};
+        if constexpr (kind == u01_kind::cc)
+          traits::cc(r, u, m);
+        else if constexpr (kind == u01_kind::co)
+          traits::co(r, u, m);
+        else if constexpr (kind == u01_kind::oc)
+          traits::oc(r, u, m);
+        else
+          traits::oo(r, u, m);
+        k(u, m);
+        for (std::size_t i{0}; i < m; ++i, ++out)
+          *out = f(u[i]);
+        n -= m;
+      }
+      return out;
+    }
+
+    template<u01_kind kind, typename ReturnType, typename PrngType, typename OutputIter,
+             typename Transform>
+    OutputIter batch_generate(PrngType &r, OutputIter out, std::size_t n, Transform f) {
+      return batch_generate<kind, ReturnType>(
+          r, out, n, [](ReturnType *, std::size_t) {}, f);
+    }
+
   }  // namespace utility
 
 }  // namespace trng
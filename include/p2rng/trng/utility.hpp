@@ -44,6 +44,7 @@
 #include <iomanip>
 #include <ios>
 #include <cstring>
+#include <cstdint>
 #include <vector>
 #include <iterator>
 #include <type_traits>
@@ -212,6 +213,216 @@ namespace trng {
       return static_cast<std::size_t>(i2);
     }
 
+    // guide table for discrete(); it has a power of two m >= max(last - first, min_size)
+    // entries, entry k is the index discrete() returns for x = k / m, a lower bound of the
+    // index for any x in [k / m, (k + 1) / m); both k / m and x * m are exact
+    template<typename iter>
+    std::vector<std::uint32_t> discrete_guide(iter first, iter last, std::size_t min_size = 0) {
+      const std::size_t n(last - first);
+      std::size_t m{1};
+      while (m < n or m < min_size)
+        m <<= 1;
+      std::vector<std::uint32_t> guide(m, 0);
+      std::size_t i{1};
+      for (std::size_t k{0}; k < m and n > 1; ++k) {
+        const double x{static_cast<double>(k) / static_cast<double>(m)};
+        if (x < first[0])
+          continue;
+        while (i + 1 < n and x > first[i])
+          ++i;
+        guide[k] = static_cast<std::uint32_t>(i);
+      }
+      return guide;
+    }
+
+    // same as discrete(x, first, last), the search starts at the guide table's entry for x and
+    // takes about one comparison on average
+    template<typename iter>
+    std::size_t discrete(double x, iter first, iter last, const std::vector<std::uint32_t> &guide) {
+      const std::size_t n(last - first);
+      if (x < (*first) or n == 1)
+        return 0;
+      std::size_t k{static_cast<std::size_t>(x * static_cast<double>(guide.size()))};
+      if (k >= guide.size())
+        k = guide.size() - 1;
+      std::size_t i{guide[k] > 0 ? guide[k] : std::size_t(1)};
+      while (i + 1 < n and x > first[i])
+        ++i;
+      return i;
+    }
+
+    // CDF of a log-concave discrete distribution on [0, max], tabulated only on the window
+    // [lo, hi] around the mode outside of which lies less than tail of the probability mass;
+    // beyond the window, values are found by walking the tails from its ends; probabilities
+    // are given by the ratios up(x) = pdf(x + 1) / pdf(x) and down(x) = pdf(x - 1) / pdf(x),
+    // which decrease away from the mode; the window takes O(sqrt(variance)) memory and time;
+    // the tails beyond 1e-17 are left out and reached by a different path than a whole
+    // table, so values drawn may differ in the last step of the CDF where u lies within
+    // rounding of it, and streams of distributions that use a window are not compatible
+    // with TRNG; binomial_dist tabulates the whole CDF below full_size values instead, with
+    // a guide table of at least full_guide entries, which samples faster while the table
+    // stays in the cache
+    class cdf_window {
+    public:
+      static constexpr int full_size{1 << 17};
+      static constexpr std::size_t full_guide{1 << 15};
+      static constexpr double tail{1e-17};
+      static constexpr std::size_t guide_scale{8};
+
+    private:
+      int lo_{0}, hi_{0}, max_{0};
+      double below_{0.0}, p_lo_{1.0}, p_hi_{1.0};  // P(X < lo), pdf(lo), pdf(hi)
+      std::vector<double> P_{1.0};                  // P_[i] = P(X <= lo + i)
+      std::vector<std::uint32_t> G_{0};             // guide table of P_
+
+      // mass beyond x in direction dir up to end, p being pdf(x)
+      template<typename Step>
+      static double beyond(int x, int end, int dir, double p, Step step) {
+        double s{0.0};
+        while (x != end and p > 0.0) {
+          const double r{step(x)};
+          p *= r;
+          x += dir;
+          s += p;
+          if (r < 1.0 and p * r / (1.0 - r) < s * math::numeric_limits<double>::epsilon())
+            break;
+        }
+        return s;
+      }
+
+    public:
+      cdf_window() = default;
+      template<typename Up, typename Down>
+      cdf_window(int mode, int max, Up up, Down down) : max_{max} {
+        // unnormalized probabilities, pdf(mode) = 1
+        std::vector<double> lower{1.0}, upper;
+        double s{1.0}, p{1.0};
+        int x{mode};
+        while (x > 0) {
+          const double r{down(x)};
+          if (r < 1.0 and p * r / (1.0 - r) < tail * s)
+            break;
+          p *= r;
+          --x;
+          lower.push_back(p);
+          s += p;
+        }
+        lo_ = x;
+        p = 1.0;
+        x = mode;
+        while (x < max_) {
+          const double r{up(x)};
+          if (r < 1.0 and p * r / (1.0 - r) < tail * s)
+            break;
+          p *= r;
+          ++x;
+          upper.push_back(p);
+          s += p;
+        }
+        hi_ = x;
+        const double below{beyond(lo_, 0, -1, lower.back(), down)};
+        const double above{beyond(hi_, max_, 1, upper.empty() ? 1.0 : upper.back(), up)};
+        // build list with cumulative density function
+        P_.clear();
+        P_.reserve(lower.size() + upper.size());
+        double c{below};
+        for (auto i{lower.rbegin()}; i != lower.rend(); ++i)
+          P_.push_back(c += *i);
+        for (const auto q : upper)
+          P_.push_back(c += q);
+        const double total{c + above};
+        for (auto &q : P_)
+          q /= total;
+        below_ = below / total;
+        p_lo_ = lower.back() / total;
+        p_hi_ = (upper.empty() ? 1.0 : upper.back()) / total;
+        // the window leaves out the tails that crowd into the first and the last buckets, a
+        // guide table of the window's size would hold most values two or three to a bucket
+        G_ = discrete_guide(P_.begin(), P_.end(), guide_scale * P_.size());
+      }
+
+      int lo() const { return lo_; }
+      int hi() const { return hi_; }
+
+      // smallest x with u <= P(X <= x), beyond the window up to rounding
+      template<typename Up, typename Down>
+      int icdf(double u, Up up, Down down) const {
+        if (u <= below_ and lo_ > 0) {
+          // P(X <= x - 1) is summed up from pdf(x - 1), it is tiny compared to below_
+          int x{lo_ - 1};
+          double p{p_lo_ * down(lo_)};
+          while (x > 0 and p > 0.0) {
+            const double q{p * down(x)};
+            if (u > q + beyond(x - 1, 0, -1, q, down))
+              break;
+            p = q;
+            --x;
+          }
+          return x;
+        }
+        if (u > P_.back() and hi_ < max_) {
+          int x{hi_};
+          double p{p_hi_}, F{P_.back()};
+          while (x < max_ and u > F and p > 0.0) {
+            p *= up(x);
+            ++x;
+            F += p;
+          }
+          return x;
+        }
+        return lo_ + static_cast<int>(discrete(u, P_.begin(), P_.end(), G_));
+      }
+
+      // probability density function
+      template<typename Up, typename Down>
+      double pdf(int x, Up up, Down down) const {
+        if (x < 0 or x > max_)
+          return 0.0;
+        if (x < lo_) {
+          double p{p_lo_};
+          for (int y{lo_}; y > x and p > 0.0; --y)
+            p *= down(y);
+          return p;
+        }
+        if (x > hi_) {
+          double p{p_hi_};
+          for (int y{hi_}; y < x and p > 0.0; ++y)
+            p *= up(y);
+          return p;
+        }
+        // differences of cumulative probabilities close to one lose precision
+        const std::size_t i(x - lo_);
+        if (P_[i] <= 0.5)
+          return i == 0 ? P_[0] - below_ : P_[i] - P_[i - 1];
+        double p{p_hi_};
+        for (int y{hi_}; y > x; --y)
+          p *= down(y);
+        return p;
+      }
+
+      // cumulative density function
+      template<typename Up, typename Down>
+      double cdf(int x, Up up, Down down) const {
+        if (x < 0)
+          return 0.0;
+        if (x >= max_)
+          return 1.0;
+        if (x < lo_) {
+          const double p{pdf(x, up, down)};
+          return p + beyond(x, 0, -1, p, down);
+        }
+        if (x > hi_) {
+          double p{p_hi_}, F{P_.back()};
+          for (int y{hi_}; y < x and p > 0.0; ++y) {
+            p *= up(y);
+            F += p;
+          }
+          return F < 1.0 ? F : 1.0;
+        }
+        return P_[x - lo_];
+      }
+    };
+
     // -----------------------------------------------------------------
 
     template<typename T1, typename T2, typename... Ts>
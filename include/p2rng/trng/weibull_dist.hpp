@@ -132,6 +132,14 @@ namespace trng {
       weibull_dist g(P);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::oc, result_type>(
+          r, out, n, [this](result_type x) {
+            return P.theta() * math::pow(-math::ln(x), 1 / P.beta());
+          });
+    }
     // property methods
     P2RNG_DEVICE_CODE
     result_type min() const { return 0; }
@@ -0,0 +1,401 @@
+// Copyright (c) 2000-2022, Heiko Bauke
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions
+// are met:
+//
+//   * Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//
+//   * Redistributions in binary form must reproduce the above
+//     copyright notice, this list of conditions and the following
+//     disclaimer in the documentation and/or other materials provided
+//     with the distribution.
+//
+//   * Neither the name of the copyright holder nor the names of its
+//     contributors may be used to endorse or promote products derived
+//     from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+// FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+// COPYRIGHT HOLDERS OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+// INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+// OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#if !(defined TRNG_YARN4_HPP)
+
+#define TRNG_YARN4_HPP
+
+#include <p2rng/device.hpp>
+#include <p2rng/trng/limits.hpp>
+#include <p2rng/trng/utility.hpp>
+#include <p2rng/trng/int_types.hpp>
+#include <p2rng/trng/int_math.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <ostream>
+#include <istream>
+#include <ciso646>
+
+namespace trng {
+
+  // YARN generator: a multiple recursive generator whose output is a power of a primitive root
+  // x_i = a_1 x_(i-1) + ... + a_4 x_(i-4) mod 2^31-1
+  class yarn4 {
+  public:
+    // Uniform random number generator concept
+    using result_type = int32_t;
+    P2RNG_DEVICE_CODE result_type operator()();
+    static constexpr result_type modulus = 2147483647;
+    static constexpr result_type gen = 123567893;
+
+  private:
+    static constexpr result_type min_ = 0;
+    static constexpr result_type max_ = modulus - 1;
+
+  public:
+    P2RNG_DEVICE_CODE static constexpr result_type min() { return min_; }
+    P2RNG_DEVICE_CODE static constexpr result_type max() { return max_; }
+
+    // Parameter and status classes
+    class parameter_type {
+      result_type a[4]{0, 0, 0, 0};
+
+    public:
+      parameter_type() = default;
+      explicit parameter_type(result_type a1,
+                              result_type a2,
+                              result_type a3,
+                              result_type a4)
+          : a{a1, a2, a3, a4} {}
+
+      friend class yarn4;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const parameter_type &P1,
+                                                     const parameter_type &P2) {
+        for (int i{0}; i < 4; ++i)
+          if (P1.a[i] != P2.a[i])
+            return false;
+        return true;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const parameter_type &P1,
+                                                     const parameter_type &P2) {
+        return not(P1 == P2);
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const parameter_type &P) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << P.a[0] << ' ' << P.a[1] << ' ' << P.a[2] << ' ' << P.a[3] << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, parameter_type &P) {
+        parameter_type P_new;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> P_new.a[0] >> utility::delim(' ') >>
+            P_new.a[1] >> utility::delim(' ') >>
+            P_new.a[2] >> utility::delim(' ') >>
+            P_new.a[3] >> utility::delim(')');
+        if (in)
+          P = P_new;
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    class status_type {
+      result_type r[4]{0, 1, 1, 1};
+
+    public:
+      status_type() = default;
+
+      friend class yarn4;
+
+      // Equality comparable concept
+      friend P2RNG_DEVICE_CODE inline bool operator==(const status_type &S1,
+                                                     const status_type &S2) {
+        for (int i{0}; i < 4; ++i)
+          if (S1.r[i] != S2.r[i])
+            return false;
+        return true;
+      }
+
+      friend P2RNG_DEVICE_CODE inline bool operator!=(const status_type &S1,
+                                                     const status_type &S2) {
+        return not(S1 == S2);
+      }
+
+      // Streamable concept
+      template<typename char_t, typename traits_t>
+      friend std::basic_ostream<char_t, traits_t> &operator<<(
+          std::basic_ostream<char_t, traits_t> &out, const status_type &S) {
+        std::ios_base::fmtflags flags(out.flags());
+        out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        out << '(' << S.r[0] << ' ' << S.r[1] << ' ' << S.r[2] << ' ' << S.r[3] << ')';
+        out.flags(flags);
+        return out;
+      }
+
+      template<typename char_t, typename traits_t>
+      friend std::basic_istream<char_t, traits_t> &operator>>(
+          std::basic_istream<char_t, traits_t> &in, status_type &S) {
+        status_type S_new;
+        std::ios_base::fmtflags flags(in.flags());
+        in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+        in >> utility::delim('(') >> S_new.r[0] >> utility::delim(' ') >>
+            S_new.r[1] >> utility::delim(' ') >>
+            S_new.r[2] >> utility::delim(' ') >>
+            S_new.r[3] >> utility::delim(')');
+        if (in)
+          S = S_new;
+        in.flags(flags);
+        return in;
+      }
+    };
+
+    inline static const parameter_type Default{2001982722, 1412284257, 1155380217, 1668339922};
+    inline static const parameter_type LEcuyer1{2001982722, 1412284257, 1155380217, 1668339922};
+    inline static const parameter_type LEcuyer2{64886, 0, 0, 64322};
+
+    // Random number engine concept
+    explicit yarn4(parameter_type P = Default) : P{P} {}
+    explicit yarn4(unsigned long s, parameter_type P = Default) : P{P} { seed(s); }
+    // seeds from the generator g, not a copy constructor nor a seed value
+    template<typename gen_t,
+             typename = std::enable_if_t<not std::is_arithmetic_v<gen_t> and
+                                         not std::is_same_v<std::remove_cv_t<gen_t>, yarn4>>>
+    explicit yarn4(gen_t &g, parameter_type P = Default) : P{P} {
+      seed(g);
+    }
+
+    void seed() { (*this) = yarn4(); }
+    void seed(unsigned long s) {
+      S = status_type();
+      S.r[0] = static_cast<result_type>(s % static_cast<unsigned long>(modulus));
+    }
+    template<typename gen_t, typename = std::enable_if_t<not std::is_arithmetic_v<gen_t>>>
+    void seed(gen_t &g) {
+      for (int i{0}; i < 4; ++i)
+        S.r[i] = reduce(g());
+    }
+    void seed(result_type s1, result_type s2, result_type s3, result_type s4) {
+      S.r[0] = reduce(s1);
+      S.r[1] = reduce(s2);
+      S.r[2] = reduce(s3);
+      S.r[3] = reduce(s4);
+    }
+
+    P2RNG_DEVICE_CODE void discard(unsigned long long n) { jump(n); }
+
+    // Equality comparable concept
+    friend P2RNG_DEVICE_CODE inline bool operator==(const yarn4 &R1, const yarn4 &R2) {
+      return R1.P == R2.P and R1.S == R2.S;
+    }
+
+    friend P2RNG_DEVICE_CODE inline bool operator!=(const yarn4 &R1, const yarn4 &R2) {
+      return not(R1 == R2);
+    }
+
+    // Streamable concept
+    template<typename char_t, typename traits_t>
+    friend std::basic_ostream<char_t, traits_t> &operator<<(
+        std::basic_ostream<char_t, traits_t> &out, const yarn4 &R) {
+      std::ios_base::fmtflags flags(out.flags());
+      out.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      out << '[' << yarn4::name() << ' ' << R.P << ' ' << R.S << ']';
+      out.flags(flags);
+      return out;
+    }
+
+    template<typename char_t, typename traits_t>
+    friend std::basic_istream<char_t, traits_t> &operator>>(
+        std::basic_istream<char_t, traits_t> &in, yarn4 &R) {
+      yarn4::parameter_type P_new;
+      yarn4::status_type S_new;
+      std::ios_base::fmtflags flags(in.flags());
+      in.flags(std::ios_base::dec | std::ios_base::fixed | std::ios_base::left);
+      in >> utility::ignore_spaces();
+      in >> utility::delim('[') >> utility::delim(yarn4::name()) >> utility::delim(' ') >>
+          P_new >> utility::delim(' ') >> S_new >> utility::delim(']');
+      if (in) {
+        R.P = P_new;
+        R.S = S_new;
+      }
+      in.flags(flags);
+      return in;
+    }
+
+    // Parallel random number generator concept
+    void split(unsigned int s, unsigned int n) {
+      if (s < 1 or n >= s)
+        utility::throw_this(std::invalid_argument("invalid argument for trng::yarn4::split"));
+      if (s > 1) {
+        // 8 consecutive elements q_j = x_(n + j s) of the new sequence ...
+        int32_t q[8];
+        jump(n + 1);
+        q[0] = S.r[0];
+        for (int j{1}; j < 8; ++j) {
+          jump(s);
+          q[j] = S.r[0];
+        }
+        // ... determine its recurrence, q_(k+4) = a_1 q_(k+3) + ... + a_4 q_k
+        int32_t a[4], b[16];
+        for (int k{0}; k < 4; ++k) {
+          a[k] = q[k + 4];
+          for (int i{0}; i < 4; ++i)
+            b[k * 4 + i] = q[k + 3 - i];
+        }
+        int_math::gauss<4>(b, a, modulus);
+        for (int i{0}; i < 4; ++i) {
+          P.a[i] = a[i];
+          S.r[i] = q[3 - i];
+        }
+        // and step back to just before q_0
+        for (int i{0}; i < 4; ++i)
+          backward();
+      }
+    }
+
+    // a copy of this engine that yields every s-th number from here on
+    yarn4 leapfrog(unsigned int s) const {
+      yarn4 r{*this};
+      r.split(s, 0);
+      return r;
+    }
+
+    P2RNG_DEVICE_CODE void jump2(unsigned int s) {
+      // the companion matrix of the recurrence, raised to the power 2^s by squaring
+      int32_t b[16], c[16]{}, d[4], r[4];
+      for (int i{0}; i < 16; ++i)
+        b[i] = 0;
+      for (int i{0}; i < 4; ++i) {
+        b[i] = P.a[i];
+        if (i > 0)
+          b[i * 4 + i - 1] = 1;
+        r[i] = S.r[i];
+      }
+      for (unsigned int i{0}; i < s; ++i)
+        if ((i & 1) == 0)
+          int_math::matrix_mult<4>(b, b, c, modulus);
+        else
+          int_math::matrix_mult<4>(c, c, b, modulus);
+      if ((s & 1) == 0)
+        int_math::matrix_vec_mult<4>(b, r, d, modulus);
+      else
+        int_math::matrix_vec_mult<4>(c, r, d, modulus);
+      for (int i{0}; i < 4; ++i)
+        S.r[i] = d[i];
+    }
+
+    P2RNG_DEVICE_CODE void jump(unsigned long long s) {
+      if (s < 16) {
+        for (unsigned int i{0}; i < s; ++i)
+          step();
+      } else {
+        unsigned int i{0};
+        while (s > 0) {
+          if (s % 2 == 1)
+            jump2(i);
+          ++i;
+          s >>= 1;
+        }
+      }
+    }
+
+    // Other useful methods
+    static const char *name() { return "yarn4"; }
+    long operator()(long x) {
+      return static_cast<long>(utility::uniformco<double, yarn4>(*this) * x);
+    }
+
+  private:
+    parameter_type P;
+    status_type S;
+
+    // powers of the generator, shared by all instances and built on first use
+    static const int_math::power<modulus, gen> &g() {
+      static const int_math::power<modulus, gen> table;
+      return table;
+    }
+
+    template<typename T>
+    static result_type reduce(T s) {
+      int64_t t{static_cast<int64_t>(s) % modulus};
+      if (t < 0)
+        t += modulus;
+      return static_cast<result_type>(t);
+    }
+
+    // one step back, solves the recurrence for the element before the oldest one
+    P2RNG_DEVICE_CODE void backward() {
+      // order of the recurrence, the trailing coefficients may vanish
+      int k{4};
+      while (k > 0 and P.a[k - 1] == 0)
+        --k;
+      int64_t t{0};
+      if (k > 0) {
+        // x_(N-k) = a_1 x_(N-k+1) + ... + a_k x_N with x_N the unknown, x_0 newest
+        t = S.r[4 - k];
+        for (int j{0}; j < k - 1; ++j) {
+          t -= (static_cast<int64_t>(P.a[j]) * static_cast<int64_t>(S.r[4 - k + 1 + j])) %
+               modulus;
+          if (t < 0)
+            t += modulus;
+        }
+        t = (t * static_cast<int64_t>(int_math::modulo_inverse(P.a[k - 1], modulus))) % modulus;
+      }
+      for (int j{0}; j < 3; ++j)
+        S.r[j] = S.r[j + 1];
+      S.r[3] = static_cast<result_type>(t);
+    }
+
+    P2RNG_DEVICE_CODE void step() {
+      uint64_t t{0};
+      for (int i{0}; i < 4; ++i)
+        t += static_cast<uint64_t>(P.a[i]) * static_cast<uint64_t>(S.r[i]);
+      t = int_math::modulo<modulus, 4>(t);
+      for (int i{3}; i > 0; --i)
+        S.r[i] = S.r[i - 1];
+      S.r[0] = static_cast<result_type>(t);
+    }
+  };
+
+  P2RNG_DEVICE_CODE inline yarn4::result_type yarn4::operator()() {
+    step();
+    if (S.r[0] == 0)
+      return 0;
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__) || defined(__SYCL_DEVICE_ONLY__)
+    // no room for the power tables on the device, nor function-local statics with SYCL
+    int64_t p{1}, t{gen};
+    for (result_type n{S.r[0]}; n > 0; n >>= 1) {
+      if ((n & 0x1) == 0x1)
+        p = int_math::modulo<modulus, 1>(p * t);
+      t = int_math::modulo<modulus, 1>(t * t);
+    }
+    return static_cast<result_type>(p);
+#else
+    return g()(S.r[0]);
+#endif
+  }
+
+}  // namespace trng
+
+#endif
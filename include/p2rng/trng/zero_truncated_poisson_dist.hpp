@@ -38,10 +38,13 @@
 #include <p2rng/trng/utility.hpp>
 #include <p2rng/trng/math.hpp>
 #include <p2rng/trng/special_functions.hpp>
+#include <cstddef>
+#include <cstring>
 #include <ostream>
 #include <istream>
 #include <iomanip>
 #include <vector>
+#include <cstdint>
 #include <ciso646>
 
 namespace trng {
@@ -55,6 +58,7 @@ namespace trng {
     private:
       double mu_{0};
       std::vector<double> P_;
+      std::vector<std::uint32_t> G_;  // guide table of P_
 
       void calc_probabilities() {
         P_ = std::vector<double>();
@@ -66,6 +70,7 @@ namespace trng {
           ++x;
         }
         P_.push_back(1);
+        G_ = utility::discrete_guide(P_.begin(), P_.end());
       }
 
     public:
@@ -76,23 +81,23 @@ namespace trng {
       }
       param_type() = default;
       explicit param_type(double mu) : mu_{mu} { calc_probabilities(); }
+      // binary checkpoint (see p2rng::serializer), the parameters only
+      static constexpr std::size_t serialized_size{sizeof(mu_)};
+      void serialize(std::byte *out) const {
+        std::memcpy(out, &mu_, sizeof(mu_));
+      }
+      void deserialize(const std::byte *in) {
+        std::memcpy(&mu_, in, sizeof(mu_));
+        calc_probabilities();
+      }
       friend class zero_truncated_poisson_dist;
     };
 
   private:
     param_type P;
 
-  public:
-    // constructor
-    explicit zero_truncated_poisson_dist(double mu) : P{mu} {}
-    explicit zero_truncated_poisson_dist(const param_type &P) : P{P} {}
-    // reset internal state
-    void reset() {}
-    // random numbers
-    template<typename R>
-    int operator()(R &r) {
-      double p{utility::uniformco<double>(r)};
-      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end())};
+    int icdf_(double p) const {
+      const std::size_t x{utility::discrete(p, P.P_.begin(), P.P_.end(), P.G_)};
       int x_i{static_cast<int>(x)};
       if (x + 1 == P.P_.size()) {
         p -= cdf(x_i);
@@ -103,11 +108,29 @@ namespace trng {
       }
       return x_i;
     }
+
+  public:
+    // constructor
+    explicit zero_truncated_poisson_dist(double mu) : P{mu} {}
+    explicit zero_truncated_poisson_dist(const param_type &P) : P{P} {}
+    // reset internal state
+    void reset() {}
+    // random numbers
+    template<typename R>
+    int operator()(R &r) {
+      return icdf_(utility::uniformco<double>(r));
+    }
     template<typename R>
     int operator()(R &r, const param_type &p) {
       zero_truncated_poisson_dist g(p);
       return g(r);
     }
+    // batch of random numbers, same as n calls to operator()(r)
+    template<typename R, typename OutputIter>
+    OutputIter generate(R &r, OutputIter out, std::size_t n) {
+      return utility::batch_generate<utility::u01_kind::co, double>(
+          r, out, n, [this](double x) { return icdf_(x); });
+    }
     // property methods
     int min() const { return 1; }
     int max() const { return math::numeric_limits<int>::max(); }
@@ -0,0 +1,357 @@
+//
+// Copyright (c) 2023 Armin Sobhani (https://arminsobhani.ca)
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+#ifndef _P2RNG_XOSHIRO_XOSHIRO_HPP_
+#define _P2RNG_XOSHIRO_XOSHIRO_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <p2rng/device.hpp>
+
+namespace p2rng {
+
+namespace detail {
+
+P2RNG_DEVICE_CODE
+constexpr std::uint64_t rotl(std::uint64_t x, unsigned k)
+{   return (x << k) | (x >> (64 - k));   }
+
+P2RNG_DEVICE_CODE
+constexpr std::uint64_t splitmix64(std::uint64_t& x)
+{   std::uint64_t z = (x += 0x9e3779b97f4a7c15u);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+    return z ^ (z >> 31);
+}
+
+// The linear engines of Blackman and Vigna, "Scrambled linear pseudorandom
+// number generators", ACM TOMS 47(4), 2021. charpoly() holds the low words
+// of the characteristic polynomial (x^degree is implied), jump() and
+// long_jump() the polynomials x^(2^(degree/2)) and x^(2^(3*degree/4)) of
+// the reference implementation.
+
+struct xoshiro256
+{   static constexpr std::size_t words = 4;
+
+    P2RNG_DEVICE_CODE
+    static constexpr void step(std::uint64_t (&s)[words])
+    {   const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t charpoly(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0x9d116f2bb0f0f001u, 0x0280002bcefd1a5eu
+        ,   0x04b4edcf26259f85u, 0x0003c03c3f3ecb19u
+        };
+        return p[w];
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t jump(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0x180ec6d33cfd0abau, 0xd5a61266f0c9392cu
+        ,   0xa9582618e03fc9aau, 0x39abdc4529b1661cu
+        };
+        return p[w];
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t long_jump(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0x76e15d3efefdcbbfu, 0xc5004e441c522fb3u
+        ,   0x77710069854ee241u, 0x39109bb02acbe635u
+        };
+        return p[w];
+    }
+};
+
+struct xoroshiro128
+{   static constexpr std::size_t words = 2;
+
+    P2RNG_DEVICE_CODE
+    static constexpr void step(std::uint64_t (&s)[words])
+    {   const std::uint64_t s1 = s[0] ^ s[1];
+        s[0] = rotl(s[0], 24) ^ s1 ^ (s1 << 16);
+        s[1] = rotl(s1, 37);
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t charpoly(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0x095b8f76579aa001u, 0x0008828e513b43d5u   };
+        return p[w];
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t jump(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0xdf900294d8f554a5u, 0x170865df4b3201fcu   };
+        return p[w];
+    }
+
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t long_jump(std::size_t w)
+    {   const std::uint64_t p[words]
+        {   0xd2a98b26625eee7bu, 0xdddf9b1090aa7ac1u   };
+        return p[w];
+    }
+};
+
+// the scramblers, applied to the state before it is advanced
+
+struct plus
+{   template <std::size_t W>
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t apply(const std::uint64_t (&s)[W])
+    {   return s[0] + s[W - 1];   }
+};
+
+struct starstar
+{   template <std::size_t W>
+    P2RNG_DEVICE_CODE
+    static constexpr std::uint64_t apply(const std::uint64_t (&s)[W])
+    {   return rotl(s[4 == W ? 1 : 0] * 5, 7) * 9;   }
+};
+
+// a = a^2 mod the characteristic polynomial of Linear, over GF(2)
+template <typename Linear>
+P2RNG_DEVICE_CODE
+constexpr void square_mod(std::uint64_t (&a)[Linear::words])
+{   constexpr std::size_t W = Linear::words, degree = 64 * W;
+    std::uint64_t t[2 * W]{};
+    // squaring spreads the bits of a to the even positions
+    for (std::size_t i = 0; i < degree; ++i)
+        if (a[i / 64] >> (i % 64) & 1)
+            t[2 * i / 64] |= std::uint64_t(1) << (2 * i % 64);
+    // x^i = x^(i - degree) * charpoly, from the top down
+    for (std::size_t i = 2 * degree - 2; i >= degree; --i)
+    {   if (0 == (t[i / 64] >> (i % 64) & 1))
+            continue;
+        t[i / 64] ^= std::uint64_t(1) << (i % 64);
+        const std::size_t q = (i - degree) / 64, r = (i - degree) % 64;
+        for (std::size_t w = 0; w < W; ++w)
+        {   t[w + q] ^= Linear::charpoly(w) << r;
+            if (r)
+                t[w + q + 1] ^= Linear::charpoly(w) >> (64 - r);
+        }
+    }
+    for (std::size_t w = 0; w < W; ++w)
+        a[w] = t[w];
+}
+
+/**
+ *  Jump polynomials of Linear: entry k is x^(2^k) mod its characteristic
+ *  polynomial, which advances the engine by 2^k steps. Built at compile
+ *  time by repeated squaring.
+ */
+template <typename Linear>
+struct xoshiro_jump_table
+{   static constexpr std::size_t size = 64;
+
+    std::uint64_t poly[size][Linear::words];
+
+    constexpr xoshiro_jump_table() : poly()
+    {   std::uint64_t a[Linear::words]{2};   // x
+        for (std::size_t k = 0; k < size; ++k)
+        {   for (std::size_t w = 0; w < Linear::words; ++w)
+                poly[k][w] = a[w];
+            square_mod<Linear>(a);
+        }
+    }
+};
+
+template <typename Linear>
+inline constexpr xoshiro_jump_table<Linear> xoshiro_jump_table_v{};
+
+} // end detail namespace
+
+/**
+ *  @brief xoshiro/xoroshiro random number engine of Blackman and Vigna.
+ *
+ *  A 64-bit generator with a 2^256 - 1 (xoshiro256) or 2^128 - 1
+ *  (xoroshiro128) period, seeded through splitmix64 as its authors
+ *  recommend.
+ *
+ *  @a discard(n) takes the low bits of @a n in single steps and each of the
+ *  others, 2^k, by applying the precomputed polynomial x^(2^k), so any
+ *  distance costs at most 64 polynomial applications instead of @a n steps.
+ *  @a jump() and @a long_jump() advance by 2^128 and 2^192 (xoshiro256) or
+ *  2^64 and 2^96 (xoroshiro128) steps to split the sequence into
+ *  non-overlapping streams.
+ *
+ *  @tparam Linear    the linear engine, @a detail::xoshiro256 or
+ *                    @a detail::xoroshiro128
+ *  @tparam Scrambler output function, @a detail::plus or @a detail::starstar
+ */
+template <typename Linear, typename Scrambler>
+class xoshiro_engine
+{   static constexpr std::size_t W = Linear::words;
+    static constexpr std::size_t degree = 64 * W;
+
+public:
+    typedef std::uint64_t result_type;
+    typedef std::uint64_t state_type;
+
+    static constexpr std::size_t word_count = W;
+    static constexpr std::uint64_t default_seed = 0xcafef00dd15ea5e5u;
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type min()
+    {   return 0;   }
+
+    P2RNG_DEVICE_CODE
+    static constexpr result_type max()
+    {   return ~result_type(0);   }
+
+    P2RNG_DEVICE_CODE
+    explicit xoshiro_engine(std::uint64_t seed = default_seed)
+    {   this->seed(seed);   }
+
+    P2RNG_DEVICE_CODE
+    void seed(std::uint64_t s = default_seed)
+    {   for (std::size_t w = 0; w < W; ++w)
+            _s[w] = detail::splitmix64(s);
+    }
+
+    P2RNG_DEVICE_CODE
+    result_type operator() ()
+    {   const result_type r = Scrambler::apply(_s);
+        Linear::step(_s);
+        return r;
+    }
+
+    /// advances the engine by @a z steps
+    P2RNG_DEVICE_CODE
+    void discard(state_type z)
+    {   // 2^k steps are cheaper than a polynomial below the degree
+        constexpr std::size_t direct = degree - 1;
+        for (state_type i = z & direct; i > 0; --i)
+            Linear::step(_s);
+        z &= ~state_type(direct);
+#if defined(__CUDA_ARCH__) || defined(__HIP_DEVICE_COMPILE__)
+        // no access to the table, square as we go
+        std::uint64_t a[W]{2};
+        for (std::size_t k = 0; z; ++k, z >>= 1)
+        {   if (z & 1)
+                apply(a);
+            detail::square_mod<Linear>(a);
+        }
+#else
+        const auto& table = detail::xoshiro_jump_table_v<Linear>;
+        for (std::size_t k = 0; z; ++k, z >>= 1)
+            if (z & 1)
+                apply(table.poly[k]);
+#endif
+    }
+
+    /// advances the engine by 2^(degree/2) steps
+    P2RNG_DEVICE_CODE
+    void jump()
+    {   std::uint64_t p[W]{};
+        for (std::size_t w = 0; w < W; ++w)
+            p[w] = Linear::jump(w);
+        apply(p);
+    }
+
+    /// advances the engine by 2^(3*degree/4) steps
+    P2RNG_DEVICE_CODE
+    void long_jump()
+    {   std::uint64_t p[W]{};
+        for (std::size_t w = 0; w < W; ++w)
+            p[w] = Linear::long_jump(w);
+        apply(p);
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator==
+    (   const xoshiro_engine& lhs
+    ,   const xoshiro_engine& rhs
+    )
+    {   for (std::size_t w = 0; w < W; ++w)
+            if (lhs._s[w] != rhs._s[w])
+                return false;
+        return true;
+    }
+
+    P2RNG_DEVICE_CODE
+    friend bool operator!=
+    (   const xoshiro_engine& lhs
+    ,   const xoshiro_engine& rhs
+    )
+    {   return !(lhs == rhs);   }
+
+private:
+    // the state becomes p(x) applied to it: the sum of the states after i
+    // steps over the coefficients i of p that are set
+    P2RNG_DEVICE_CODE
+    void apply(const std::uint64_t (&p)[W])
+    {   // on copies, which p can't alias
+        std::uint64_t s[W], t[W]{};
+        for (std::size_t i = 0; i < W; ++i)
+            s[i] = _s[i];
+        for (std::size_t w = 0; w < W; ++w)
+        {   const std::uint64_t bits = p[w];
+            for (std::size_t b = 0; b < 64; ++b)
+            {   // a mask rather than a branch, the bits are random
+                const std::uint64_t m = 0 - (bits >> b & 1);
+                accumulate(t, s, m, std::make_index_sequence<W>{});
+                Linear::step(s);
+            }
+        }
+        for (std::size_t i = 0; i < W; ++i)
+            _s[i] = t[i];
+    }
+
+    // t ^= s & m, unrolled so that the words stay in registers
+    template <std::size_t... i>
+    P2RNG_DEVICE_CODE
+    static void accumulate
+    (   std::uint64_t (&t)[W]
+    ,   const std::uint64_t (&s)[W]
+    ,   std::uint64_t m
+    ,   std::index_sequence<i...>
+    )
+    {   ((t[i] ^= s[i] & m), ...);   }
+
+    std::uint64_t _s[W];
+};
+
+/// xoshiro256**: all-purpose 64-bit generator
+typedef xoshiro_engine<detail::xoshiro256, detail::starstar> xoshiro256starstar;
+
+/// xoshiro256+: for floating-point numbers, which only use the upper bits
+typedef xoshiro_engine<detail::xoshiro256, detail::plus> xoshiro256plus;
+
+/// xoroshiro128+: smaller state, for floating-point numbers
+typedef xoshiro_engine<detail::xoroshiro128, detail::plus> xoroshiro128plus;
+
+} // end p2rng namespace
+
+#endif  //_P2RNG_XOSHIRO_XOSHIRO_HPP_
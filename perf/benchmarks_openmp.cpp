@@ -1,12 +1,40 @@
 #include <algorithm>
 #include <functional>
+#include <sstream>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <p2rng/bind.hpp>
 #include <p2rng/pcg/pcg_random.hpp>
+#include <p2rng/cbrng/philox.hpp>
+#include <p2rng/cbrng/threefry.hpp>
+#include <p2rng/xoshiro/xoshiro.hpp>
+#include <p2rng/mrg/mrg32k3a.hpp>
+#include <p2rng/trng/lcg64.hpp>
+#include <p2rng/trng/lcg64_shift.hpp>
+#include <p2rng/trng/mrg3.hpp>
+#include <p2rng/trng/yarn2.hpp>
+#include <p2rng/trng/yarn3.hpp>
+#include <p2rng/trng/yarn4.hpp>
+#include <p2rng/trng/yarn5.hpp>
+#include <p2rng/trng/mt19937_64.hpp>
 #include <p2rng/trng/uniform_dist.hpp>
+#include <p2rng/trng/uniform_int_dist.hpp>
+#include <p2rng/trng/fast_uniform_int_dist.hpp>
+#include <p2rng/trng/normal_dist.hpp>
+#include <p2rng/trng/fast_normal_dist.hpp>
+#include <p2rng/trng/gamma_dist.hpp>
+#include <p2rng/trng/beta_dist.hpp>
+#include <p2rng/trng/binomial_dist.hpp>
+#include <p2rng/trng/poisson_dist.hpp>
+#include <p2rng/trng/discrete_dist.hpp>
+#include <p2rng/trng/fast_discrete_dist.hpp>
+#include <p2rng/execution.hpp>
+#include <p2rng/executor.hpp>
+#include <p2rng/serialize.hpp>
+#include <p2rng/engine_array.hpp>
+#include <p2rng/tabulated_icdf.hpp>
 #include <p2rng/algorithm/generate.hpp>
 
 const unsigned long seed_pi{3141592654};
@@ -72,6 +100,1071 @@ BENCHMARK_TEMPLATE(p2rng_generate_openmp, double)
 ->  UseRealTime()
 ->  Unit(benchmark::kMillisecond);
 
+// integers in [10, 100): through a double, against multiply-high
+template <class Dist>
+void p2rng_generate_int_openmp(benchmark::State& st)
+{   typedef typename Dist::result_type T;
+    size_t n = size_t(st.range());
+    std::vector<T> v(n);
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(Dist(10, 100), pcg32(seed_pi))
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_int_openmp, trng::uniform_int_dist)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_int_openmp, trng::fast_uniform_int_dist<int>)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_int_openmp, trng::fast_uniform_int_dist<std::int64_t>)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// a million categories: every thread with its own copy of the tree of partial
+// sums, against a view of the one tree
+template <bool View>
+void p2rng_generate_discrete_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<int> v(n);
+    std::vector<double> w(1 << 20);
+    for (size_t i = 0; i < w.size(); ++i)
+        w[i] = 1.0 + double(i % 17);
+    trng::discrete_dist d(std::begin(w), std::end(w));
+
+    for (auto _ : st)
+    {   if constexpr (View)
+            p2rng::generate_n(std::begin(v), n, p2rng::bind(d.view(), pcg32(seed_pi)));
+        else
+            p2rng::generate_n(std::begin(v), n, p2rng::bind(d, pcg32(seed_pi)));
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(int)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_discrete_openmp, false)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_discrete_openmp, true)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+// 16M categories by the alias method, 8-byte (float) versus 16-byte (double)
+// table entries
+template <typename T>
+void p2rng_generate_alias_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<int> v(n);
+    std::vector<double> w(1 << 24);
+    for (size_t i = 0; i < w.size(); ++i)
+        w[i] = 1.0 + double(i % 17);
+    trng::alias_table<T> t(std::begin(w), std::end(w));
+
+    for (auto _ : st)
+        p2rng::generate_n(std::begin(v), n, p2rng::bind(t.view(), pcg32(seed_pi)));
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(int)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_alias_openmp, float)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_alias_openmp, double)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// small outputs: calibrated team size versus always all threads (grain 1)
+template <class T, size_t Grain>
+void p2rng_generate_small_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    p2rng::execution::policy policy;
+    policy.grain = Grain;
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi))
+        ,   policy
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_small_openmp, float, 0)
+->  RangeMultiplier(4)
+->  Range(1<<8, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_small_openmp, float, 1)
+->  RangeMultiplier(4)
+->  Range(1<<8, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+template <class T>
+void p2rng_generate_openmp_streaming(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    p2rng::execution::policy policy;
+    policy.store = p2rng::execution::store::streaming;
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi))
+        ,   policy
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_openmp_streaming, float)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_openmp_streaming, double)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// scalar inv_Phi versus the array version of fast_normal_dist
+template <class Dist>
+void p2rng_generate_normal_openmp(benchmark::State& st)
+{   typedef typename Dist::result_type T;
+    size_t n = size_t(st.range());
+    std::vector<T> v(n);
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(Dist(0, 1), pcg32(seed_pi))
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_normal_openmp, trng::normal_dist<float>)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_normal_openmp, trng::normal_dist<double>)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_normal_openmp, trng::fast_normal_dist<float>)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_normal_openmp, trng::fast_normal_dist<double>)
+->  RangeMultiplier(2)
+->  Range(1<<20, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// CDF inversion, whole tables for small n (binomial) or mu (poisson), windows beyond
+template <class Dist>
+void p2rng_generate_cdf_openmp(benchmark::State& st)
+{   const size_t n = 1 << 22;
+    std::vector<int> v(n);
+    Dist d = [&]
+    {   if constexpr (std::is_same_v<Dist, trng::binomial_dist>)
+            return Dist(0.3, int(st.range()));
+        else
+            return Dist(double(st.range()));
+    }();
+
+    for (auto _ : st)
+        p2rng::generate_n(std::begin(v), n, p2rng::bind(d, pcg32(seed_pi)));
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(int)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_cdf_openmp, trng::binomial_dist)
+->  RangeMultiplier(10)
+->  Range(10, 1'000'000)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_cdf_openmp, trng::poisson_dist)
+->  RangeMultiplier(10)
+->  Range(10, 1'000'000)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// quantiles solved for iteratively on every sample versus tabulated
+template <class Dist, bool Tabulated>
+void p2rng_generate_icdf_openmp(benchmark::State& st)
+{   typedef typename Dist::result_type T;
+    size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    Dist d = [&]
+    {   if constexpr (std::is_same_v<Dist, trng::beta_dist<T>>)
+            return Dist(2, 5);
+        else
+            return Dist(2.5, 1);
+    }();
+    p2rng::tabulated_icdf<Dist> t(d);
+
+    for (auto _ : st)
+    {   if constexpr (Tabulated)
+            p2rng::generate_n(std::begin(v), n, p2rng::bind(t, pcg32(seed_pi)));
+        else
+            p2rng::generate_n(std::begin(v), n, p2rng::bind(d, pcg32(seed_pi)));
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_icdf_openmp, trng::beta_dist<double>, false)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_icdf_openmp, trng::beta_dist<double>, true)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_icdf_openmp, trng::gamma_dist<double>, false)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_icdf_openmp, trng::gamma_dist<double>, true)
+->  RangeMultiplier(16)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// gamma_dist has a varying per-sample cost (Newton iterations in icdf)
+template <class T, p2rng::execution::schedule Schedule>
+void p2rng_generate_gamma_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    p2rng::execution::policy policy;
+    policy.schedule = Schedule;
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(trng::gamma_dist<T>(0.5, 1), pcg32(seed_pi))
+        ,   policy
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_gamma_openmp, double, p2rng::execution::schedule::static_blocks)
+->  RangeMultiplier(4)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_gamma_openmp, double, p2rng::execution::schedule::dynamic)
+->  RangeMultiplier(4)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_gamma_openmp, double, p2rng::execution::schedule::guided)
+->  RangeMultiplier(4)
+->  Range(1<<16, 1<<20)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+// block splitting against leapfrogging the engine, raw and with a distribution
+template <class Engine, p2rng::execution::partition Partition>
+void p2rng_generate_partition_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<typename Engine::result_type> v(n);
+    p2rng::execution::policy policy;
+    policy.partition = Partition;
+
+    for (auto _ : st)
+        p2rng::generate_n(std::begin(v), n, Engine(seed_pi), policy);
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(typename Engine::result_type)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, pcg32, p2rng::execution::partition::blocks)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, pcg32, p2rng::execution::partition::leapfrog)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, pcg64, p2rng::execution::partition::blocks)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, pcg64, p2rng::execution::partition::leapfrog)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, trng::yarn3, p2rng::execution::partition::blocks)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_partition_openmp, trng::yarn3, p2rng::execution::partition::leapfrog)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+template <class T, p2rng::execution::partition Partition>
+void p2rng_generate_uniform_partition_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    p2rng::execution::policy policy;
+    policy.partition = Partition;
+
+    for (auto _ : st)
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi))
+        ,   policy
+        );
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_uniform_partition_openmp, float, p2rng::execution::partition::blocks)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_uniform_partition_openmp, float, p2rng::execution::partition::leapfrog)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+// k-dimensionally equidistributed engines: every thread with its own copy
+// of the extension table, against one table shared by all
+template <class Engine, bool Shared>
+void p2rng_generate_extended_openmp(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<typename Engine::result_type> v(n);
+    Engine g(seed_pi);
+    auto table = g.share();
+
+    for (auto _ : st)
+    {   if constexpr (Shared)
+            p2rng::generate_n(std::begin(v), n, table.generator());
+        else
+            p2rng::generate_n(std::begin(v), n, g);
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(typename Engine::result_type)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_extended_openmp, pcg32_k1024, false)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_extended_openmp, pcg32_k1024, true)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_extended_openmp, pcg32_k16384, false)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_extended_openmp, pcg32_k16384, true)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+//----------------------------------------------------------------------------//
+// executors: many small refills of the same buffer, as in a simulation loop
+
+template <class T, p2rng::executor::kind Kind>
+void p2rng_generate_refills(benchmark::State& st)
+{   const size_t refills{64};
+    size_t n = size_t(st.range());
+    std::vector<T> v(n);
+    p2rng::executor ex(Kind);
+    auto g = p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi));
+
+    for (auto _ : st)
+    {   if constexpr (Kind == p2rng::executor::kind::orphaned)
+        {
+            #pragma omp parallel
+            for (size_t i = 0; i < refills; ++i)
+                p2rng::generate_n(ex, std::begin(v), n, g);
+        }
+        else
+        {   for (size_t i = 0; i < refills; ++i)
+                p2rng::generate_n(ex, std::begin(v), n, g);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (refills * n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(p2rng_generate_refills, float, p2rng::executor::kind::openmp)
+->  RangeMultiplier(4)
+->  Range(1<<8, 1<<16)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_refills, float, p2rng::executor::kind::thread_pool)
+->  RangeMultiplier(4)
+->  Range(1<<8, 1<<16)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(p2rng_generate_refills, float, p2rng::executor::kind::orphaned)
+->  RangeMultiplier(4)
+->  Range(1<<8, 1<<16)
+->  UseRealTime()
+->  Unit(benchmark::kMicrosecond);
+
+//----------------------------------------------------------------------------//
+// NUMA placement: allocate, generate and read back in parallel, the read is
+// where remote pages hurt on multi-socket nodes
+
+template <class T>
+T parallel_sum(const T* p, size_t n)
+{   T sum{0};
+    #pragma omp parallel for reduction(+:sum)
+    for (size_t i = 0; i < n; ++i)
+        sum += p[i];
+    return sum;
+}
+
+template <class T>
+void numa_vector(benchmark::State& st)
+{   size_t n = size_t(st.range());
+
+    for (auto _ : st)
+    {   std::vector<T> v(n);    // zero-filled by the calling thread
+        p2rng::generate_n
+        (   std::begin(v)
+        ,   n
+        ,   p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi))
+        );
+        benchmark::DoNotOptimize(parallel_sum(v.data(), n));
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(numa_vector, double)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<26)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+template <class T, p2rng::numa::placement_policy Policy>
+void numa_random_array(benchmark::State& st)
+{   size_t n = size_t(st.range());
+
+    for (auto _ : st)
+    {   auto a = p2rng::make_random_array<T>
+        (   n
+        ,   p2rng::bind(trng::uniform_dist<T>(10, 100), pcg32(seed_pi))
+        ,   p2rng::numa::placement{Policy, 0}
+        );
+        benchmark::DoNotOptimize(parallel_sum(a.data(), n));
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(T)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(numa_random_array, double, p2rng::numa::placement_policy::local)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<26)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(numa_random_array, double, p2rng::numa::placement_policy::interleaved)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<26)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(numa_random_array, double, p2rng::numa::placement_policy::node)
+->  RangeMultiplier(4)
+->  Range(1<<20, 1<<26)
+->  UseRealTime()
+->  Unit(benchmark::kMillisecond);
+
+//----------------------------------------------------------------------------//
+// engines
+
+// pcg64 and pcg64_fast on the portable 128-bit class, to compare against the
+// native unsigned __int128 path
+
+typedef pcg_engines::setseq_base
+<   uint64_t
+,   pcg_extras::pcg128_emulated_t
+,   pcg_detail::xsl_rr_mixin
+>   pcg64_emulated;
+
+typedef pcg_engines::mcg_base
+<   uint64_t
+,   pcg_extras::pcg128_emulated_t
+,   pcg_detail::xsl_rr_mixin
+>   pcg64_fast_emulated;
+
+template <class Engine>
+void engine_scalar(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<typename Engine::result_type> v(n);
+    Engine g(seed_pi);
+
+    for (auto _ : st)
+    {   for (auto& x : v)
+            x = g();
+        benchmark::DoNotOptimize(v.data());
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(typename Engine::result_type)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(engine_scalar, pcg32)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, pcg64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, pcg64_emulated)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, pcg64_fast)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, pcg64_fast_emulated)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::philox4x32)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::philox2x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::threefry4x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::threefry2x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::xoshiro256starstar)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::xoshiro256plus)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::xoroshiro128plus)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, p2rng::mrg32k3a)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::lcg64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::lcg64_shift)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::mrg3)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::yarn2)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::yarn3)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::yarn4)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::yarn5)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_scalar, trng::mt19937_64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+template <class Engine>
+void engine_fill(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<typename Engine::result_type> v(n);
+    Engine g(seed_pi);
+
+    for (auto _ : st)
+    {   g.fill(std::begin(v), n);
+        benchmark::DoNotOptimize(v.data());
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * sizeof(typename Engine::result_type)) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(engine_fill, pcg32)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, pcg64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, pcg64_emulated)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, pcg64_fast)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, pcg64_fast_emulated)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, p2rng::philox4x32)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, p2rng::philox2x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, p2rng::threefry4x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(engine_fill, p2rng::threefry2x64)
+->  RangeMultiplier(4)
+->  Range(1<<12, 1<<20)
+->  Unit(benchmark::kMicrosecond);
+
+// cost of discard() versus the jump distance
+
+template <class Engine>
+void engine_discard(benchmark::State& st)
+{   std::uint64_t d = std::uint64_t(st.range());
+    Engine g(seed_pi);
+
+    for (auto _ : st)
+    {   g.discard(d);
+        benchmark::DoNotOptimize(g);
+    }
+}
+
+BENCHMARK_TEMPLATE(engine_discard, pcg32)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg32_oneseq)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg32_fast)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg32_once_insecure)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<30)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg64_once_insecure)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg64)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, pcg64_emulated)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::philox4x32)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::philox2x64)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::threefry4x64)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::threefry2x64)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::xoshiro256starstar)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::xoshiro256plus)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::xoroshiro128plus)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, p2rng::mrg32k3a)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, trng::lcg64)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, trng::lcg64_shift)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, trng::mrg3)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, trng::yarn3)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+BENCHMARK_TEMPLATE(engine_discard, trng::yarn5)
+->  RangeMultiplier(256)
+->  Range(1, int64_t(1)<<56)
+->  Unit(benchmark::kNanosecond);
+
+//----------------------------------------------------------------------------//
+// checkpoints: saving and restoring many engines, binary against the stream
+// operators; the rate is that of the binary size in both cases
+
+template <class Engine>
+std::vector<Engine> make_engines(size_t n)
+{   std::vector<Engine> ve(n, Engine(seed_pi));
+    for (size_t i = 0; i < n; ++i)
+        ve[i].discard(i);
+    return ve;
+}
+
+template <class Engine, bool Binary>
+void checkpoint_save(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    auto ve = make_engines<Engine>(n);
+    std::vector<std::byte> buf(n * p2rng::serialized_size_v<Engine>);
+
+    for (auto _ : st)
+    {   if constexpr (Binary)
+            p2rng::serialize(ve.data(), n, buf.data());
+        else
+        {   std::ostringstream os;
+            for (const auto& e : ve)
+                os << e << '\n';
+            benchmark::DoNotOptimize(os.str());
+        }
+        benchmark::DoNotOptimize(buf.data());
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * p2rng::serialized_size_v<Engine>) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+template <class Engine, bool Binary>
+void checkpoint_load(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    auto ve = make_engines<Engine>(n);
+    std::vector<std::byte> buf(n * p2rng::serialized_size_v<Engine>);
+    p2rng::serialize(ve.data(), n, buf.data());
+    std::ostringstream os;
+    for (const auto& e : ve)
+        os << e << '\n';
+    const std::string text = os.str();
+
+    for (auto _ : st)
+    {   if constexpr (Binary)
+            p2rng::deserialize(buf.data(), n, ve.data());
+        else
+        {   std::istringstream is(text);
+            for (auto& e : ve)
+                is >> e;
+        }
+        benchmark::DoNotOptimize(ve.data());
+    }
+
+    st.counters["BW (GB/s)"] = benchmark::Counter
+    (   (n * p2rng::serialized_size_v<Engine>) / 1e9
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(checkpoint_save, pcg32, true)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_save, pcg32, false)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_load, pcg32, true)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_load, pcg32, false)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_save, trng::yarn5, true)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_save, trng::yarn5, false)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_load, trng::yarn5, true)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(checkpoint_load, trng::yarn5, false)
+->  RangeMultiplier(16)
+->  Range(1<<10, 1<<18)
+->  Unit(benchmark::kMicrosecond);
+
+//----------------------------------------------------------------------------//
+// many independent engines: one step of every engine, kept as an array of
+// engine objects (AoS) against the columns of a p2rng::engine_array (SoA)
+
+template <class Engine, bool SoA>
+void agents_step(benchmark::State& st)
+{   size_t n = size_t(st.range());
+    std::vector<typename Engine::result_type> vr(n);
+    p2rng::executor ex;
+
+    if constexpr (SoA)
+    {   p2rng::engine_array<Engine> a(ex, n, seed_pi);
+        for (auto _ : st)
+        {   a.step_all(ex, vr.data());
+            benchmark::DoNotOptimize(vr.data());
+        }
+    }
+    else
+    {   std::vector<Engine> ve(n);
+        #pragma omp parallel for
+        for (size_t i = 0; i < n; ++i)
+            ve[i] = Engine(seed_pi, i);
+        for (auto _ : st)
+        {
+            #pragma omp parallel for
+            for (size_t i = 0; i < n; ++i)
+                vr[i] = ve[i]();
+            benchmark::DoNotOptimize(vr.data());
+        }
+    }
+
+    st.counters["Agents/s"] = benchmark::Counter
+    (   double(n)
+    ,   benchmark::Counter::kIsIterationInvariantRate
+    );
+}
+
+BENCHMARK_TEMPLATE(agents_step, pcg32, false)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(agents_step, pcg32, true)
+->  RangeMultiplier(16)
+->  Range(1<<12, 1<<24)
+->  Unit(benchmark::kMicrosecond);
+
 //----------------------------------------------------------------------------//
 // main()
 
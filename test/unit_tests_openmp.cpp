@@ -1,14 +1,53 @@
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <functional>
 #include <numeric>
+#include <random>
+#include <sstream>
 #include <vector>
 
 #include <catch2/catch_all.hpp>
 
 #include <p2rng/bind.hpp>
 #include <p2rng/pcg/pcg_random.hpp>
+#include <p2rng/cbrng/philox.hpp>
+#include <p2rng/cbrng/threefry.hpp>
+#include <p2rng/xoshiro/xoshiro.hpp>
+#include <p2rng/mrg/mrg32k3a.hpp>
+#include <p2rng/trng/lcg64.hpp>
+#include <p2rng/trng/lcg64_shift.hpp>
+#include <p2rng/trng/mrg3.hpp>
+#include <p2rng/trng/yarn2.hpp>
+#include <p2rng/trng/yarn3.hpp>
+#include <p2rng/trng/yarn4.hpp>
+#include <p2rng/trng/yarn5.hpp>
+#include <p2rng/trng/mt19937_64.hpp>
 #include <p2rng/trng/uniform_dist.hpp>
 #include <p2rng/trng/uniform_int_dist.hpp>
+#include <p2rng/trng/fast_uniform_int_dist.hpp>
+#include <p2rng/trng/normal_dist.hpp>
+#include <p2rng/trng/fast_normal_dist.hpp>
+#include <p2rng/trng/lognormal_dist.hpp>
+#include <p2rng/trng/truncated_normal_dist.hpp>
+#include <p2rng/trng/exponential_dist.hpp>
+#include <p2rng/trng/poisson_dist.hpp>
+#include <p2rng/trng/discrete_dist.hpp>
+#include <p2rng/trng/fast_discrete_dist.hpp>
+#include <p2rng/trng/gamma_dist.hpp>
+#include <p2rng/trng/binomial_dist.hpp>
+#include <p2rng/trng/hypergeometric_dist.hpp>
+#include <p2rng/trng/negative_binomial_dist.hpp>
+#include <p2rng/trng/zero_truncated_poisson_dist.hpp>
+#include <p2rng/trng/beta_dist.hpp>
+#include <p2rng/trng/student_t_dist.hpp>
+#include <p2rng/trng/chi_square_dist.hpp>
+#include <p2rng/trng/snedecor_f_dist.hpp>
+#include <p2rng/trng/maxwell_dist.hpp>
+#include <p2rng/execution.hpp>
+#include <p2rng/serialize.hpp>
+#include <p2rng/engine_array.hpp>
+#include <p2rng/tabulated_icdf.hpp>
 #include <p2rng/algorithm/generate.hpp>
 
 const unsigned long seed_pi{3141592654};
@@ -20,6 +59,8 @@ TEMPLATE_TEST_CASE( "generate_n() - OpenMP", "[10K][pcg32]", float, double)
     trng::uniform_dist<T> u(10, 100);
     std::vector<T> vr(n), vt(n);
     std::vector<size_t> idx(n);
+    p2rng::execution::policy policy;
+    policy.grain = 1;   // all threads, however small the output
 
     std::iota(std::begin(idx), std::end(idx), 0);
 
@@ -43,6 +84,7 @@ TEMPLATE_TEST_CASE( "generate_n() - OpenMP", "[10K][pcg32]", float, double)
         (   std::begin(vt)
         ,   n
         ,   p2rng::bind(u, pcg32(seed_pi))
+        ,   policy
         );
 
         CHECK(itr == std::end(vt));
@@ -63,6 +105,8 @@ TEMPLATE_TEST_CASE( "generate() - OpenMP", "[10K][pcg32]", float, double)
     trng::uniform_dist<T> u(10, 100);
     std::vector<T> vr(n), vt(n);
     std::vector<size_t> idx(n);
+    p2rng::execution::policy policy;
+    policy.grain = 1;   // all threads, however small the output
 
     std::iota(std::begin(idx), std::end(idx), 0);
 
@@ -87,6 +131,7 @@ TEMPLATE_TEST_CASE( "generate() - OpenMP", "[10K][pcg32]", float, double)
         (   std::begin(vt)
         ,   std::end(vt)
         ,   p2rng::bind(u, pcg32(seed_pi))
+        ,   policy
         );
 
         CHECK( std::all_of
@@ -105,6 +150,8 @@ TEMPLATE_TEST_CASE( "uniform_int_dist - OpenMP", "[10K][pcg32][dist]", int)
     trng::uniform_int_dist u(10, 100);
     std::vector<T> vr(n), vt(n);
     std::vector<size_t> idx(n);
+    p2rng::execution::policy policy;
+    policy.grain = 1;
 
     std::iota(std::begin(idx), std::end(idx), 0);
 
@@ -117,6 +164,7 @@ TEMPLATE_TEST_CASE( "uniform_int_dist - OpenMP", "[10K][pcg32][dist]", int)
     (   std::begin(vt)
     ,   n
     ,   p2rng::bind(u, pcg32(seed_pi))
+    ,   policy
     );
     CHECK( std::all_of
     (   std::begin(idx)
@@ -125,3 +173,1842 @@ TEMPLATE_TEST_CASE( "uniform_int_dist - OpenMP", "[10K][pcg32][dist]", int)
         { return ( std::abs(vr[i] - vt[i]) < 0.00001 ); }
     ) );
 }
+
+TEMPLATE_TEST_CASE
+(   "fill() - PCG engines"
+,   "[10K][pcg]"
+,   pcg32
+,   pcg32_oneseq
+,   pcg32_fast
+,   pcg32_once_insecure
+)
+{   typedef TestType E;
+    typedef typename E::result_type T;
+
+    for (std::size_t n : {0, 1, 15, 16, 17, 10'007})
+    {   E ge(seed_pi), gf(seed_pi);
+        std::vector<T> vr(n), vt(n);
+
+        std::generate_n(std::begin(vr), n, std::ref(ge));
+        gf.fill(std::begin(vt), n);
+
+        CHECK(vr == vt);
+        CHECK(ge == gf);
+        CHECK(ge() == gf());
+    }
+}
+
+TEMPLATE_TEST_CASE( "generate_n() - OpenMP engine", "[10K][pcg32]", pcg32, pcg32_fast)
+{   typedef TestType E;
+    typedef typename E::result_type T;
+    const auto n{10'007};
+
+    std::vector<T> vr(n), vt(n);
+    p2rng::execution::policy policy;
+    policy.grain = 1;
+
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+    p2rng::generate_n(std::begin(vt), n, E(seed_pi), policy);
+
+    CHECK(vr == vt);
+}
+
+// the batch kernels of some distributions differ in the last bits, by at
+// most eps; with @a leapfrog, the distribution draws one number per sample
+// and the leapfrog partition (blocks if the engine has none) must agree with
+// the blocks exactly and with a serial run up to eps; returns the reference
+// samples
+template <class Distribution, class Engine = pcg32>
+std::vector<typename Distribution::result_type> check_generate
+(   Distribution d
+,   double eps = 0
+,   Engine e = Engine(seed_pi)
+,   bool leapfrog = false
+)
+{   typedef typename Distribution::result_type T;
+    auto close = [eps] (const std::vector<T>& a, const std::vector<T>& b)
+    {   for (std::size_t i = 0; i < a.size(); ++i)
+            if  (   a[i] != b[i]
+                &&  std::abs(double(a[i]) - double(b[i]))
+                >   eps * std::max(1.0, std::abs(double(a[i])))
+                )
+                return false;
+        return true;
+    };
+
+    for (std::size_t n : {0, 1, 255, 256, 257, 10'007})
+    {   Engine ge(e), gb(e);
+        std::vector<T> vr(n), vt(n);
+
+        std::generate_n(std::begin(vr), n, std::bind(d, std::ref(ge)));
+        auto itr = d.generate(gb, std::begin(vt), n);
+
+        CHECK(itr == std::end(vt));
+        CHECK(close(vr, vt));
+        CHECK(ge == gb);
+    }
+
+    const std::size_t n{10'007};
+    std::vector<T> vr(n), vt(n);
+    p2rng::execution::policy policy;
+    policy.grain = 1;
+
+    std::generate_n(std::begin(vr), n, std::bind(d, Engine(e)));
+    CHECK(std::all_of
+    (   std::begin(vr)
+    ,   std::end(vr)
+    ,   [&](T x) { return d.min() <= x && x <= d.max(); }
+    ) );
+    p2rng::generate_n(std::begin(vt), n, p2rng::bind(d, e), policy);
+    CHECK(close(vr, vt));
+    p2rng::executor ex(p2rng::executor::kind::thread_pool, 4);
+    std::fill(std::begin(vt), std::end(vt), T(0));
+    p2rng::generate_n(ex, std::begin(vt), n, p2rng::bind(d, e), policy);
+    CHECK(close(vr, vt));
+
+    if (leapfrog)
+    {   p2rng::execution::policy lf{policy};
+        lf.partition = p2rng::execution::partition::leapfrog;
+        std::vector<T> vb(n), vl(n);
+        for (std::size_t offset : {0, 3})
+        {   p2rng::generate_n
+            (   vb.data() + offset
+            ,   n - offset
+            ,   p2rng::bind(d, e)
+            ,   policy
+            );
+            p2rng::generate_n
+            (   vl.data() + offset
+            ,   n - offset
+            ,   p2rng::bind(d, e)
+            ,   lf
+            );
+            CHECK(vb == vl);
+            CHECK(close
+            (   std::vector<T>(std::begin(vr), std::end(vr) - offset)
+            ,   std::vector<T>(std::begin(vl) + offset, std::end(vl))
+            ) );
+        }
+    }
+
+    return vr;
+}
+
+TEST_CASE( "generate() - TRNG distributions", "[10K][pcg32][dist]")
+{   SECTION("uniform_dist")
+    {   check_generate(trng::uniform_dist<float>(10, 100));
+        check_generate(trng::uniform_dist<double>(10, 100));
+    }
+    SECTION("uniform_int_dist")
+    {   check_generate(trng::uniform_int_dist(10, 100));
+    }
+    SECTION("normal_dist")
+    {   check_generate(trng::normal_dist<float>(0, 1));
+        check_generate(trng::normal_dist<double>(5, 2));
+    }
+    SECTION("lognormal_dist")
+    {   check_generate(trng::lognormal_dist<double>(0, 1));
+    }
+    SECTION("truncated_normal_dist")
+    {   check_generate(trng::truncated_normal_dist<double>(0, 1, -1, 3));
+    }
+    SECTION("fast_normal_dist")
+    {   // the array inv_Phi is not bitwise identical to the scalar one, which
+        // loses some accuracy in the upper tail
+        auto vf = check_generate(trng::fast_normal_dist<double>(5, 2));
+        auto vr = check_generate(trng::normal_dist<double>(5, 2));
+        for (std::size_t i = 0; i < vr.size(); ++i)
+            CHECK(std::abs(vf[i] - vr[i]) <= 1e-8 * std::max(1.0, std::abs(vr[i])));
+        check_generate(trng::fast_normal_dist<float>(0, 1));
+    }
+    SECTION("exponential_dist")
+    {   check_generate(trng::exponential_dist<double>(2));
+    }
+    SECTION("poisson_dist")
+    {   check_generate(trng::poisson_dist(4.5));
+    }
+    SECTION("discrete_dist")
+    {   std::vector<double> w{1, 2, 3, 4, 5, 6, 7};
+        check_generate(trng::discrete_dist(std::begin(w), std::end(w)));
+        check_generate(trng::fast_discrete_dist(std::begin(w), std::end(w)));
+    }
+}
+
+TEMPLATE_TEST_CASE( "inv_Phi() - array version", "[10K][math]", float, double)
+{   typedef TestType T;
+    const auto n{10'007};
+    const T eps = std::is_same_v<T, float> ? 1e-6 : 1e-14;
+
+    std::vector<T> x(n), y(n);
+    std::vector<size_t> idx(n);
+
+    std::iota(std::begin(idx), std::end(idx), 0);
+    std::generate_n
+    (   std::begin(x)
+    ,   n
+    ,   std::bind(trng::uniform_dist<T>(0, 1), pcg32(seed_pi))
+    );
+    // tails and special values
+    x[0] = T(0); x[1] = T(1); x[2] = T(-1); x[3] = T(2);
+    x[4] = T(1e-30); x[5] = T(1) - std::numeric_limits<T>::epsilon();
+
+    trng::math::inv_Phi(x.data(), y.data(), n);
+
+    CHECK(y[0] == -std::numeric_limits<T>::infinity());
+    CHECK(y[1] == std::numeric_limits<T>::infinity());
+    CHECK(std::isnan(y[2]));
+    CHECK(std::isnan(y[3]));
+    // lower half by forward error, upper half by backward error, as there
+    // inv_Phi is ill-conditioned
+    CHECK( std::all_of
+    (   std::begin(idx) + 4
+    ,   std::end(idx)
+    ,   [&] (size_t i)
+        {   const long double xl = x[i], yl = y[i];
+            if (xl < 0.5l)
+            {   const long double r = trng::math::inv_Phi(xl);
+                return std::abs(yl - r) <= eps * std::max(1.0l, std::abs(r));
+            }
+            return std::abs(trng::math::Phi(yl) - xl)
+                <= 4 * std::numeric_limits<T>::epsilon();
+        }
+    ) );
+}
+
+TEMPLATE_TEST_CASE( "generate_n() - streaming stores", "[10K][pcg32]", float, double)
+{   typedef TestType T;
+    p2rng::execution::policy policy;
+    policy.store = p2rng::execution::store::streaming;
+    policy.grain = 1;
+
+    for (std::size_t n : {0, 1, 100, 10'007, 100'003})
+    {   trng::uniform_dist<T> u(10, 100);
+        std::vector<T> vr(n), vt(n + 1);
+
+        std::generate_n(std::begin(vr), n, std::bind(u, pcg32(seed_pi)));
+
+        // unaligned start, the head is written without streaming stores
+        auto itr = p2rng::generate_n
+        (   std::begin(vt) + 1
+        ,   n
+        ,   p2rng::bind(u, pcg32(seed_pi))
+        ,   policy
+        );
+
+        CHECK(itr == std::end(vt));
+        CHECK(std::equal(std::begin(vr), std::end(vr), std::begin(vt) + 1));
+    }
+}
+
+TEMPLATE_TEST_CASE( "make_random_array() - OpenMP", "[10K][pcg32]", float, double)
+{   typedef TestType T;
+    const auto n{100'003};
+
+    trng::uniform_dist<T> u(10, 100);
+    std::vector<T> vr(n);
+    std::generate_n(std::begin(vr), n, std::bind(u, pcg32(seed_pi)));
+
+    const p2rng::numa::placement places[]
+    {   p2rng::numa::local
+    ,   p2rng::numa::interleaved
+    ,   p2rng::numa::on_node(0)
+    };
+
+    for (auto where : places)
+    {   auto a = p2rng::make_random_array<T>(n, p2rng::bind(u, pcg32(seed_pi)), where);
+
+        CHECK(a.size() == std::size_t(n));
+        CHECK(std::equal(std::begin(vr), std::end(vr), std::begin(a)));
+        if (p2rng::numa::placement_policy::local == where.policy)
+            CHECK(a.placed());
+    }
+
+    // a node that can't exist is reported, the array still works
+    auto b = p2rng::make_random_array<T>
+    (   n
+    ,   p2rng::bind(u, pcg32(seed_pi))
+    ,   p2rng::numa::on_node(64)
+    );
+    CHECK(!b.placed());
+    CHECK(std::equal(std::begin(vr), std::end(vr), std::begin(b)));
+
+    auto e = p2rng::make_random_array<T>(0, p2rng::bind(u, pcg32(seed_pi)));
+    CHECK(e.empty());
+    CHECK(e.begin() == e.end());
+}
+
+TEMPLATE_TEST_CASE( "generate_n() - schedules", "[10K][pcg32]", float, double)
+{   typedef TestType T;
+    const auto n{100'003};
+
+    trng::gamma_dist<T> d(2, 3);
+    std::vector<T> vr(n), vt(n);
+    std::generate_n(std::begin(vr), n, std::bind(d, pcg32(seed_pi)));
+
+    const p2rng::execution::schedule schedules[]
+    {   p2rng::execution::schedule::dynamic
+    ,   p2rng::execution::schedule::guided
+    };
+
+    for (auto schedule : schedules)
+    {   for (std::size_t chunk_size : {0, 1, 1000, 1'000'000})
+        {   p2rng::execution::policy policy;
+            policy.schedule = schedule;
+            policy.chunk_size = chunk_size;
+            policy.grain = 1;   // all threads, however small the output
+            std::fill(std::begin(vt), std::end(vt), T(0));
+
+            auto itr = p2rng::generate_n
+            (   std::begin(vt)
+            ,   n
+            ,   p2rng::bind(d, pcg32(seed_pi))
+            ,   policy
+            );
+
+            CHECK(itr == std::end(vt));
+            CHECK(vr == vt);
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "discard() - PCG engines"
+,   "[pcg]"
+,   pcg32
+,   pcg32_oneseq
+,   pcg32_fast
+,   pcg8_once_insecure
+,   pcg16_once_insecure
+,   pcg32_once_insecure
+,   pcg64_once_insecure
+,   pcg64
+,   pcg64_fast
+,   pcg128_once_insecure
+)
+{   typedef TestType E;
+    typedef typename E::state_type S;
+
+    SECTION("same as consecutive calls")
+    {   E ge{S(seed_pi)};
+        for (std::size_t d : {0, 1, 2, 3, 7, 64, 1'000})
+        {   E gd = ge;
+            for (std::size_t i = 0; i < d; ++i)
+                ge();
+            gd.discard(S(d));
+            CHECK(ge == gd);
+        }
+    }
+
+    SECTION("long jumps")
+    {   const S d1 = S(0x9e3779b97f4a7c15ull), d2 = S(0x2545f4914f6cdd1dull);
+        E g1{S(seed_pi)}, g2{S(seed_pi)};
+        g1.discard(S(d1 + d2));
+        g2.discard(d1);
+        g2.discard(d2);
+        CHECK(g1 == g2);
+        g1.backstep(S(d1 + d2));
+        CHECK(g1 == E(S(seed_pi)));
+    }
+}
+
+TEST_CASE( "pcg64 - native and emulated 128-bit math", "[pcg]")
+{   typedef pcg_engines::setseq_base
+    <   uint64_t
+    ,   pcg_extras::pcg128_emulated_t
+    ,   pcg_detail::xsl_rr_mixin
+    >   pcg64_emulated;
+    typedef pcg_engines::mcg_base
+    <   uint64_t
+    ,   pcg_extras::pcg128_emulated_t
+    ,   pcg_detail::xsl_rr_mixin
+    >   pcg64_fast_emulated;
+
+    const std::size_t n{10'007};
+    std::vector<uint64_t> vr(n), vt(n);
+
+    SECTION("pcg64")
+    {   pcg64 r(seed_pi, 54);
+        pcg64_emulated t(seed_pi, 54);
+        std::generate(std::begin(vr), std::end(vr), std::ref(r));
+        std::generate(std::begin(vt), std::end(vt), std::ref(t));
+        CHECK(vr == vt);
+
+        r.discard(0x9e3779b97f4a7c15ull);
+        t.discard(0x9e3779b97f4a7c15ull);
+        r.fill(std::begin(vr), n);
+        t.fill(std::begin(vt), n);
+        CHECK(vr == vt);
+    }
+
+    SECTION("pcg64_fast")
+    {   pcg64_fast r(seed_pi);
+        pcg64_fast_emulated t(seed_pi);
+        std::generate(std::begin(vr), std::end(vr), std::ref(r));
+        std::generate(std::begin(vt), std::end(vt), std::ref(t));
+        CHECK(vr == vt);
+
+        r.discard(0x9e3779b97f4a7c15ull);
+        t.discard(0x9e3779b97f4a7c15ull);
+        r.fill(std::begin(vr), n);
+        t.fill(std::begin(vt), n);
+        CHECK(vr == vt);
+    }
+}
+
+TEMPLATE_TEST_CASE( "generate_n() - executor", "[10K][pcg32]", float, double)
+{   typedef TestType T;
+    const auto n{100'003};
+
+    trng::gamma_dist<T> d(2, 3);
+    std::vector<T> vr(n), vt(n);
+    std::generate_n(std::begin(vr), n, std::bind(d, pcg32(seed_pi)));
+
+    const p2rng::execution::schedule schedules[]
+    {   p2rng::execution::schedule::static_blocks
+    ,   p2rng::execution::schedule::dynamic
+    ,   p2rng::execution::schedule::guided
+    };
+
+    auto check = [&](p2rng::executor& ex)
+    {   for (auto schedule : schedules)
+        {   p2rng::execution::policy policy;
+            policy.schedule = schedule;
+            policy.chunk_size = 1000;
+            policy.grain = 1;
+            // reused for many small and one large range
+            for (std::size_t m : {0, 1, 7, 100, 4097})
+            {   std::fill(std::begin(vt), std::end(vt), T(0));
+                auto itr = p2rng::generate_n
+                (   ex
+                ,   std::begin(vt)
+                ,   m
+                ,   p2rng::bind(d, pcg32(seed_pi))
+                ,   policy
+                );
+                CHECK(itr == std::begin(vt) + m);
+                CHECK(std::equal(std::begin(vt), itr, std::begin(vr)));
+            }
+            std::fill(std::begin(vt), std::end(vt), T(0));
+            p2rng::generate
+            (   ex
+            ,   std::begin(vt)
+            ,   std::end(vt)
+            ,   p2rng::bind(d, pcg32(seed_pi))
+            ,   policy
+            );
+            CHECK(vr == vt);
+        }
+    };
+
+    SECTION("openmp")
+    {   p2rng::executor ex;
+        check(ex);
+        p2rng::executor ex3(p2rng::executor::kind::openmp, 3);
+        CHECK(ex3.size() == 3);
+        check(ex3);
+    }
+
+    SECTION("thread_pool")
+    {   for (std::size_t size : {1, 2, 5})
+        {   p2rng::executor ex(p2rng::executor::kind::thread_pool, size);
+            CHECK(ex.size() == size);
+            check(ex);
+        }
+        p2rng::executor ex
+        (   p2rng::executor::kind::thread_pool
+        ,   3
+        ,   p2rng::executor::affinity::compact
+        );
+        check(ex);
+    }
+
+    SECTION("orphaned")
+    {   p2rng::executor ex(p2rng::executor::kind::orphaned);
+        std::vector<T> vo(n);
+        #pragma omp parallel
+        {   for (auto schedule : schedules)
+            {   p2rng::execution::policy policy;
+                policy.schedule = schedule;
+                policy.grain = 1;
+                p2rng::generate_n
+                (   ex
+                ,   std::begin(vo)
+                ,   n
+                ,   p2rng::bind(d, pcg32(seed_pi))
+                ,   policy
+                );
+                #pragma omp single
+                {   CHECK(vr == vo);
+                    std::fill(std::begin(vo), std::end(vo), T(0));
+                }
+            }
+        }
+    }
+
+    SECTION("scratch")
+    {   p2rng::executor ex(p2rng::executor::kind::thread_pool, 2);
+        auto p = ex.scratch<T>(1, 100);
+        CHECK(reinterpret_cast<std::uintptr_t>(p) % p2rng::cache_line_size == 0);
+        CHECK(ex.scratch<T>(1, 10) == p);
+        CHECK(ex.scratch<T>(2, 10) == nullptr);
+
+        // made on first use, by whichever member of the team comes first
+        p2rng::executor ey(p2rng::executor::kind::thread_pool, 3);
+        std::atomic<int> ok{0};
+        ey.run
+        (   [&](std::size_t tidx, std::size_t)
+            {   auto q = ey.scratch<T>(tidx, 1000);
+                if (reinterpret_cast<std::uintptr_t>(q) % p2rng::cache_line_size == 0)
+                    ok += nullptr != q;
+            }
+        );
+        CHECK(3 == ok);
+    }
+}
+
+TEMPLATE_TEST_CASE( "generate_n() - adaptive team size", "[10K][pcg32]", float, double)
+{   typedef TestType T;
+    typedef decltype(p2rng::bind(trng::uniform_dist<T>(0, 1), pcg32())) cheap;
+    typedef decltype(p2rng::bind(trng::normal_dist<T>(0, 1), pcg32())) moderate;
+    typedef decltype(p2rng::bind(trng::gamma_dist<T>(2, 3), pcg32())) expensive;
+
+    STATIC_REQUIRE(p2rng::sample_cost_v<pcg32> == p2rng::cost_class::cheap);
+    STATIC_REQUIRE(p2rng::sample_cost_v<cheap> == p2rng::cost_class::cheap);
+    STATIC_REQUIRE(p2rng::sample_cost_v<moderate> == p2rng::cost_class::moderate);
+    STATIC_REQUIRE(p2rng::sample_cost_v<expensive> == p2rng::cost_class::expensive);
+
+    SECTION("team size")
+    {   using p2rng::detail::team_size;
+        const auto c = p2rng::cost_class::cheap;
+        const auto e = p2rng::cost_class::expensive;
+        CHECK(team_size(1, c, 8, 1) == 1);
+        CHECK(team_size(1000, c, 8, 1) == 8);
+        CHECK(team_size(1000, c, 8, 1024) == 1);
+        CHECK(team_size(3000, c, 8, 1024) == 2);
+        CHECK(team_size(3000, e, 8, 1024) == 8);
+        const auto grain = p2rng::detail::calibrated_grain();
+        CHECK(grain >= 1024);
+        CHECK(team_size(grain - 1, c, 8, 0) == 1);
+        CHECK(team_size(8 * grain, c, 8, 0) == 8);
+        // calibrated outside of parallel regions, and cached
+        int differ{0};
+        #pragma omp parallel reduction(+:differ)
+        differ += p2rng::detail::calibrated_grain() != grain;
+        CHECK(0 == differ);
+    }
+
+    SECTION("same output for every team size")
+    {   trng::uniform_dist<T> u(10, 100);
+        for (std::size_t n : {1, 100, 4'097, 100'003})
+        {   std::vector<T> vr(n), vt(n);
+            std::generate_n(std::begin(vr), n, std::bind(u, pcg32(seed_pi)));
+            for (std::size_t grain : {0, 1, 1000, 1 << 20})
+            {   p2rng::execution::policy policy;
+                policy.grain = grain;
+                std::fill(std::begin(vt), std::end(vt), T(0));
+                p2rng::generate_n
+                (   std::begin(vt)
+                ,   n
+                ,   p2rng::bind(u, pcg32(seed_pi))
+                ,   policy
+                );
+                CHECK(vr == vt);
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "generate_n() - leapfrog"
+,   "[10K][leapfrog]"
+,   pcg32
+,   pcg32_fast
+,   pcg64
+,   trng::lcg64
+,   trng::yarn3
+)
+{   typedef TestType E;
+    typedef typename E::result_type R;
+    const std::size_t n{100'003};
+
+    static_assert(p2rng::has_leapfrog_v<E>);
+    static_assert(!p2rng::has_leapfrog_v<pcg32_k2>);
+
+    std::vector<R> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+
+    SECTION("leapfrog engine")
+    {   for (std::size_t stride : {1, 2, 7, 16, 100})
+        {   E g(seed_pi);
+            g.discard(3);
+            auto h = g.leapfrog(stride);
+            for (std::size_t j = 0; j < 100; ++j)
+                CHECK(h() == vr[3 + j * stride]);
+            h.discard(5);
+            CHECK(h() == vr[3 + 105 * stride]);
+        }
+    }
+
+    SECTION("generate_n()")
+    {   p2rng::execution::policy policy;
+        policy.partition = p2rng::execution::partition::leapfrog;
+        policy.grain = 1;   // all threads, however small the output
+        const p2rng::execution::store stores[]
+        {   p2rng::execution::store::temporal
+        ,   p2rng::execution::store::streaming
+        };
+
+        auto check = [&](p2rng::executor& ex)
+        {   std::vector<R> vt(n + 8);
+            for (auto store : stores)
+            {   policy.store = store;
+                // with and without a ragged first cache line
+                for (std::size_t offset : {0, 1, 5})
+                {   for (std::size_t m : {0, 1, 7, 100, 4097, 100'003})
+                    {   std::fill(std::begin(vt), std::end(vt), R(0));
+                        auto out = vt.data() + offset;
+                        auto itr = p2rng::generate_n
+                        (   ex
+                        ,   out
+                        ,   m
+                        ,   E(seed_pi)
+                        ,   policy
+                        );
+                        CHECK(itr == out + m);
+                        CHECK(std::equal(out, itr, std::begin(vr)));
+                        CHECK( std::all_of
+                        (   itr
+                        ,   vt.data() + vt.size()
+                        ,   [](R x) { return R(0) == x; }
+                        ) );
+                    }
+                }
+            }
+        };
+        p2rng::executor ex;
+        check(ex);
+        p2rng::executor ex3(p2rng::executor::kind::thread_pool, 3);
+        check(ex3);
+    }
+
+    SECTION("bind")
+    {   p2rng::execution::policy policy;
+        policy.partition = p2rng::execution::partition::leapfrog;
+        policy.grain = 1;
+
+        trng::uniform_dist<double> u(10, 100);
+        std::vector<double> ur(n), ut(n);
+        std::generate_n(std::begin(ur), n, std::bind(u, E(seed_pi)));
+        p2rng::generate_n(std::begin(ut), n, p2rng::bind(u, E(seed_pi)), policy);
+        CHECK(ur == ut);
+    }
+}
+
+TEST_CASE( "Philox engines - known answers", "[philox]")
+{   // Random123 known-answer tests of the bijection
+    SECTION("philox4x32")
+    {   typedef p2rng::philox4x32 E;
+        const std::uint32_t ctr[3][4]
+        {   {0, 0, 0, 0}
+        ,   {~0u, ~0u, ~0u, ~0u}
+        ,   {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}
+        };
+        const std::uint32_t key[3][2]
+        {   {0, 0}
+        ,   {~0u, ~0u}
+        ,   {0xa4093822, 0x299f31d0}
+        };
+        const std::uint32_t kat[3][4]
+        {   {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}
+        ,   {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}
+        ,   {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}
+        };
+        for (int t = 0; t < 3; ++t)
+        {   std::uint32_t out[4];
+            E::bijection(ctr[t], key[t], out);
+            CHECK(std::equal(out, out + 4, kat[t]));
+        }
+    }
+
+    SECTION("philox2x64")
+    {   typedef p2rng::philox2x64 E;
+        const std::uint64_t ctr[3][2]
+        {   {0, 0}
+        ,   {~0ull, ~0ull}
+        ,   {0x243f6a8885a308d3ull, 0x13198a2e03707344ull}
+        };
+        const std::uint64_t key[3][1]
+        {   {0}
+        ,   {~0ull}
+        ,   {0xa4093822299f31d0ull}
+        };
+        const std::uint64_t kat[3][2]
+        {   {0xca00a0459843d731ull, 0x66c24222c9a845b5ull}
+        ,   {0x65b021d60cd8310full, 0x4d02f3222f86df20ull}
+        ,   {0x0a5e742c2997341cull, 0xb0f883d38000de5dull}
+        };
+        for (int t = 0; t < 3; ++t)
+        {   std::uint64_t out[2];
+            E::bijection(ctr[t], key[t], out);
+            CHECK(std::equal(out, out + 2, kat[t]));
+        }
+    }
+}
+
+TEST_CASE( "Threefry engines - known answers", "[threefry]")
+{   // Random123 known-answer tests of the bijection
+    const std::uint64_t ctr[3][4]
+    {   {0, 0, 0, 0}
+    ,   {~0ull, ~0ull, ~0ull, ~0ull}
+    ,   {   0x243f6a8885a308d3ull, 0x13198a2e03707344ull
+        ,   0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull
+        }
+    };
+
+    SECTION("threefry4x64")
+    {   typedef p2rng::threefry4x64 E;
+        const std::uint64_t key[3][4]
+        {   {0, 0, 0, 0}
+        ,   {~0ull, ~0ull, ~0ull, ~0ull}
+        ,   {   0x452821e638d01377ull, 0xbe5466cf34e90c6cull
+            ,   0xbe5466cf34e90c6cull, 0xc0ac29b7c97c50ddull
+            }
+        };
+        const std::uint64_t kat[3][4]
+        {   {   0x09218ebde6c85537ull, 0x55941f5266d86105ull
+            ,   0x4bd25e16282434dcull, 0xee29ec846bd2e40bull
+            }
+        ,   {   0x29c24097942bba1bull, 0x0371bbfb0f6f4e11ull
+            ,   0x3c231ffa33f83a1cull, 0xcd29113fde32d168ull
+            }
+        ,   {   0xa7e8fde591651bd9ull, 0xbaafd0c30138319bull
+            ,   0x84a5c1a729e685b9ull, 0x901d406ccebc1ba4ull
+            }
+        };
+        for (int t = 0; t < 3; ++t)
+        {   std::uint64_t out[4];
+            E::bijection(ctr[t], key[t], out);
+            CHECK(std::equal(out, out + 4, kat[t]));
+        }
+    }
+
+    SECTION("threefry2x64")
+    {   typedef p2rng::threefry2x64 E;
+        const std::uint64_t key[3][2]
+        {   {0, 0}
+        ,   {~0ull, ~0ull}
+        ,   {0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull}
+        };
+        const std::uint64_t kat[3][2]
+        {   {0xc2b6e3a8c2c69865ull, 0x6f81ed42f350084dull}
+        ,   {0xe02cb7c4d95d277aull, 0xd06633d0893b8b68ull}
+        ,   {0x263c7d30bb0f0af1ull, 0x56be8361d3311526ull}
+        };
+        for (int t = 0; t < 3; ++t)
+        {   std::uint64_t out[2];
+            E::bijection(ctr[t], key[t], out);
+            CHECK(std::equal(out, out + 2, kat[t]));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "Counter-based engines"
+,   "[10K][philox][threefry]"
+,   p2rng::philox4x32
+,   p2rng::philox2x64
+,   p2rng::threefry4x64
+,   p2rng::threefry2x64
+)
+{   typedef TestType E;
+    typedef typename E::result_type T;
+    const std::size_t n{10'007};
+
+    std::vector<T> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+
+    SECTION("counter layout")
+    {   E g(seed_pi, 7);
+        T out[E::word_count];
+        for (std::uint64_t b : {0, 1, 1'000'000})
+        {   T ctr[E::word_count]{}, key[E::key_count]{};
+            ctr[0] = T(b);
+            // the stream follows the 64-bit block index
+            ctr[64 / E::word_size] = 7;
+            key[0] = T(seed_pi);
+            E::bijection(ctr, key, out);
+
+            E h(seed_pi, 7);
+            h.discard(b * E::word_count);
+            for (std::size_t j = 0; j < E::word_count; ++j)
+                CHECK(h() == out[j]);
+        }
+        CHECK(E(seed_pi, 7) != E(seed_pi, 8));
+    }
+
+    SECTION("discard()")
+    {   for (std::size_t i : {0, 1, 3, 4, 5, 8, 999, 10'000})
+        {   E g(seed_pi);
+            g.discard(i);
+            CHECK(g() == vr[i]);
+        }
+        // in steps that cross and end on block boundaries
+        E g(seed_pi), h(seed_pi);
+        for (std::size_t step : {1, 2, 3, 4, 5, 7, 8, 9})
+        {   g.discard(step);
+            for (std::size_t i = 0; i < step; ++i)
+                h();
+            CHECK(g == h);
+            CHECK(g() == h());
+        }
+    }
+
+    SECTION("fill()")
+    {   for (std::size_t skip : {0, 1, 3})
+        {   E g(seed_pi);
+            g.discard(skip);
+            std::vector<T> vt(n - skip);
+            g.fill(std::begin(vt), n - skip);
+            CHECK(std::equal(std::begin(vt), std::end(vt), std::begin(vr) + skip));
+            E h(seed_pi);
+            h.discard(n);
+            CHECK(g == h);
+        }
+    }
+
+    SECTION("generate_n()")
+    {   std::vector<T> vt(n);
+        p2rng::execution::policy policy;
+        policy.grain = 1;
+        p2rng::generate_n(std::begin(vt), n, E(seed_pi), policy);
+        CHECK(vr == vt);
+    }
+
+    SECTION("TRNG distributions")
+    {   check_generate(trng::uniform_dist<float>(10, 100), 0, E(seed_pi));
+        check_generate(trng::uniform_dist<double>(10, 100), 0, E(seed_pi));
+        check_generate(trng::uniform_int_dist(10, 100), 0, E(seed_pi));
+        check_generate(trng::normal_dist<double>(0, 1), 0, E(seed_pi));
+        check_generate(trng::exponential_dist<double>(2), 0, E(seed_pi));
+        check_generate(trng::poisson_dist(4), 0, E(seed_pi));
+        check_generate(trng::gamma_dist<double>(2, 3), 0, E(seed_pi));
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "xoshiro engines"
+,   "[10K][xoshiro]"
+,   p2rng::xoshiro256starstar
+,   p2rng::xoshiro256plus
+,   p2rng::xoroshiro128plus
+)
+{   typedef TestType E;
+    const std::size_t n{10'007};
+
+    std::vector<std::uint64_t> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+
+    SECTION("reference outputs")
+    {   // reference implementation seeded through splitmix64(0)
+        std::uint64_t kat[3]{};
+        if constexpr (std::is_same_v<E, p2rng::xoshiro256starstar>)
+        {   kat[0] = 0x99ec5f36cb75f2b4ull;
+            kat[1] = 0xbf6e1f784956452aull;
+            kat[2] = 0x1a5f849d4933e6e0ull;
+        }
+        else if constexpr (std::is_same_v<E, p2rng::xoshiro256plus>)
+        {   kat[0] = 0xdaac60e1ed6a4f9bull;
+            kat[1] = 0x3156a1da0dc08435ull;
+            kat[2] = 0xf9ba3e3285d046abull;
+        }
+        else
+        {   kat[0] = 0x509946a41cd733a3ull;
+            kat[1] = 0xd805fcac6824536eull;
+            kat[2] = 0xdadc02f3e3cf7be3ull;
+        }
+        E g(0);
+        for (auto k : kat)
+            CHECK(g() == k);
+    }
+
+    SECTION("discard()")
+    {   for (std::size_t i : {0, 1, 127, 128, 255, 256, 257, 999, 10'000})
+        {   E g(seed_pi);
+            g.discard(i);
+            CHECK(g() == vr[i]);
+        }
+        // distances beyond the sequence above compose
+        const std::uint64_t a{0x0123456789abcdefull}, b{0xfedcba987654321ull};
+        E g(seed_pi), h(seed_pi);
+        g.discard(a);
+        g.discard(b);
+        h.discard(a + b);
+        CHECK(g == h);
+        h.discard(1);
+        CHECK(g != h);
+    }
+
+    SECTION("jump() and long_jump()")
+    {   E g(seed_pi), h(seed_pi);
+        g.jump();
+        if constexpr (2 == E::word_count)
+        {   // 2^64 steps
+            h.discard(std::uint64_t(1) << 63);
+            h.discard(std::uint64_t(1) << 63);
+            CHECK(g == h);
+        }
+        else
+            CHECK(g != h);
+        // the jumps commute with discard()
+        E u(seed_pi), v(seed_pi);
+        u.long_jump();
+        u.discard(12'345);
+        v.discard(12'345);
+        v.long_jump();
+        CHECK(u == v);
+    }
+
+    SECTION("generate_n()")
+    {   std::vector<std::uint64_t> vt(n);
+        p2rng::execution::policy policy;
+        policy.grain = 1;
+        p2rng::generate_n(std::begin(vt), n, E(seed_pi), policy);
+        CHECK(vr == vt);
+
+        trng::uniform_dist<double> u(10, 100);
+        std::vector<double> ur(n), ut(n);
+        std::generate_n(std::begin(ur), n, std::bind(u, E(seed_pi)));
+        p2rng::generate_n(std::begin(ut), n, p2rng::bind(u, E(seed_pi)), policy);
+        CHECK(ur == ut);
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "TRNG engines"
+,   "[10K][trng]"
+,   trng::lcg64
+,   trng::lcg64_shift
+,   trng::mrg3
+,   trng::yarn2
+,   trng::yarn3
+,   trng::yarn4
+,   trng::yarn5
+,   trng::mt19937_64
+)
+{   typedef TestType E;
+    typedef typename E::result_type T;
+    const std::size_t n{10'007};
+
+    std::vector<T> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+
+    SECTION("discard()")
+    {   for (std::size_t i : {0, 1, 15, 16, 17, 999, 10'000})
+        {   E g(seed_pi);
+            g.discard(i);
+            CHECK(g() == vr[i]);
+        }
+    }
+
+    SECTION("split()")
+    {   if constexpr (std::is_same_v<E, trng::mt19937_64>)
+        {   // the same sequence as the standard library's
+            std::mt19937_64 h(seed_pi);
+            CHECK(std::all_of
+            (   std::begin(vr)
+            ,   std::end(vr)
+            ,   [&h](T x) { return x == h(); }
+            ));
+        }
+        else
+        {   // stream j of s is the subsequence j, j + s, j + 2s, ...
+            for (unsigned s : {1, 2, 3, 7})
+                for (unsigned j = 0; j < s; ++j)
+                {   E g(seed_pi);
+                    g.split(s, j);
+                    bool same{true};
+                    for (std::size_t i = j; i < n; i += s)
+                        same = same && g() == vr[i];
+                    CHECK(same);
+                }
+            // and streams split again
+            E g(seed_pi);
+            g.split(3, 1);
+            g.split(2, 1);
+            bool same{true};
+            for (std::size_t i = 4; i < n; i += 6)
+                same = same && g() == vr[i];
+            CHECK(same);
+        }
+    }
+
+    SECTION("streamable")
+    {   E g(seed_pi), h;
+        g.discard(12'345);
+        std::stringstream ss;
+        ss << g;
+        ss >> h;
+        CHECK(g == h);
+        CHECK(g() == h());
+    }
+
+    SECTION("generate_n()")
+    {   p2rng::execution::policy policy;
+        policy.grain = 1;
+        std::vector<T> vt(n);
+        p2rng::generate_n(std::begin(vt), n, E(seed_pi), policy);
+        CHECK(vr == vt);
+
+        trng::uniform_dist<double> u(10, 100);
+        std::vector<double> ur(n), ut(n);
+        std::generate_n(std::begin(ur), n, std::bind(u, E(seed_pi)));
+        p2rng::generate_n(std::begin(ut), n, p2rng::bind(u, E(seed_pi)), policy);
+        CHECK(ur == ut);
+    }
+}
+
+TEST_CASE( "YARN engines - known answers", "[trng]")
+{   // first outputs of TRNG's yarn engines with the default parameters, from
+    // a default constructed engine, one seeded with seed_pi, and one whose
+    // next state is zero, for which TRNG returns 0 rather than gen^0
+    auto check = [](auto e, std::initializer_list<std::int32_t> kat)
+    {   for (auto x : kat)
+            CHECK(e() == x);
+    };
+
+    SECTION("yarn2")
+    {   typedef trng::yarn2 E;
+        check
+        (   E()
+        ,   {1974038136, 219896887, 1752007652, 794309791, 1734157609}
+        );
+        check
+        (   E(seed_pi)
+        ,   {342739968, 56917252, 1366717738, 773596914, 450197871}
+        );
+        E z;
+        z.seed(1, 593149317);
+        check(z, {0, 1974038136, 219896887, 1752007652});
+    }
+
+    SECTION("yarn3")
+    {   typedef trng::yarn3 E;
+        check
+        (   E()
+        ,   {629834160, 1487941364, 255139455, 231182444, 429067019}
+        );
+        check
+        (   E(seed_pi)
+        ,   {1037167818, 792948843, 863351509, 1075577193, 920461057}
+        );
+        E z;
+        z.seed(1, 0, 1695778382);
+        check(z, {0, 492309821, 367386969, 234691924});
+    }
+
+    SECTION("yarn4")
+    {   typedef trng::yarn4 E;
+        check
+        (   E()
+        ,   {1097817532, 1626175306, 841796982, 548704084, 1834153234}
+        );
+        check
+        (   E(seed_pi)
+        ,   {421755856, 408694649, 779034628, 1887919972, 400772987}
+        );
+        E z;
+        z.seed(1, 0, 0, 1081203491);
+        check(z, {0, 979061229, 1927241535, 1765545489});
+    }
+
+    SECTION("yarn5")
+    {   typedef trng::yarn5 E;
+        check
+        (   E()
+        ,   {692574271, 1644752271, 1146391032, 2083085423, 503266398}
+        );
+        check
+        (   E(seed_pi)
+        ,   {752184656, 1152450690, 1293035337, 1402317946, 1829075245}
+        );
+        E z;
+        z.seed(1, 0, 0, 0, 858869107);
+        check(z, {0, 0, 0, 0});
+    }
+}
+
+TEST_CASE( "MRG32k3a engine", "[10K][mrg32k3a]")
+{   typedef p2rng::mrg32k3a E;
+    const std::size_t n{10'007};
+
+    std::vector<std::uint32_t> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+
+    // stream and substream starts of RngStreams, from the jump matrices
+    // A^(2^127) and A^(2^76) published with it
+    auto start = []
+    (   const std::uint64_t (&a1)[3][3]
+    ,   const std::uint64_t (&a2)[3][3]
+    )
+    {   std::uint32_t s[6]{};
+        for (std::size_t i = 0; i < 3; ++i)
+        {   std::uint64_t t1{0}, t2{0};
+            for (std::size_t j = 0; j < 3; ++j)
+            {   t1 += a1[i][j] * 12345 % E::m1;
+                t2 += a2[i][j] * 12345 % E::m2;
+            }
+            s[i] = std::uint32_t(t1 % E::m1);
+            s[i + 3] = std::uint32_t(t2 % E::m2);
+        }
+        return E(s);
+    };
+    const std::uint64_t a1p76[3][3]
+    {   {   82758667,   1871391091, 4127413238 }
+    ,   {   3672831523, 69195019,   1871391091 }
+    ,   {   3672091415, 3528743235, 69195019   }
+    };
+    const std::uint64_t a2p76[3][3]
+    {   {   1511326704, 3759209742, 1610795712 }
+    ,   {   4292754251, 1511326704, 3889917532 }
+    ,   {   3859662829, 4292754251, 3708466080 }
+    };
+    const std::uint64_t a1p127[3][3]
+    {   {   2427906178, 3580155704, 949770784  }
+    ,   {   226153695,  1230515664, 3580155704 }
+    ,   {   1988835001, 986791581,  1230515664 }
+    };
+    const std::uint64_t a2p127[3][3]
+    {   {   1464411153, 277697599,  1610723613 }
+    ,   {   32183930,   1464411153, 1022607788 }
+    ,   {   2824425944, 32183930,   2093834863 }
+    };
+
+    SECTION("reference streams")
+    {   // first number of RngStreams with the default package seed,
+        // 0.1270111501 once divided by m1 + 1
+        E g;
+        CHECK(g() == 545508589u);
+
+        E s(1);
+        CHECK(s == start(a1p127, a2p127));
+        E u;
+        u.jump();
+        CHECK(u == start(a1p76, a2p76));
+        // a stream is 2^51 substreams
+        E v;
+        v.jump(std::uint64_t(1) << 51);
+        CHECK(v == s);
+    }
+
+    SECTION("discard()")
+    {   for (std::size_t i : {0, 1, 15, 16, 17, 31, 32, 999, 10'000})
+        {   E g(seed_pi);
+            g.discard(i);
+            CHECK(g() == vr[i]);
+        }
+        const std::uint64_t a{0x0123456789abcdefull}, b{0xfedcba987654321ull};
+        E g(seed_pi), h(seed_pi);
+        g.discard(a);
+        g.discard(b);
+        h.discard(a + b);
+        CHECK(g == h);
+        h.discard(1);
+        CHECK(g != h);
+        // a substream is 2^76 = 2^14 * 2^62 steps
+        E u(seed_pi), v(seed_pi);
+        for (int i = 0; i < 1 << 14; ++i)
+            u.discard(std::uint64_t(1) << 62);
+        v.jump();
+        CHECK(u == v);
+    }
+
+    SECTION("generate_n()")
+    {   std::vector<std::uint32_t> vt(n);
+        p2rng::execution::policy policy;
+        policy.grain = 1;
+        p2rng::generate_n(std::begin(vt), n, E(seed_pi), policy);
+        CHECK(vr == vt);
+
+        trng::uniform_dist<double> u(10, 100);
+        std::vector<double> ur(n), ut(n);
+        std::generate_n(std::begin(ur), n, std::bind(u, E(seed_pi)));
+        p2rng::generate_n(std::begin(ut), n, p2rng::bind(u, E(seed_pi)), policy);
+        CHECK(ur == ut);
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "bind - batch kernels"
+,   "[10K][leapfrog][dist]"
+,   pcg32
+,   pcg32_fast
+,   pcg64
+,   p2rng::xoshiro256starstar
+,   p2rng::xoshiro256plus
+,   p2rng::xoroshiro128plus
+,   p2rng::mrg32k3a
+,   trng::lcg64
+,   trng::lcg64_shift
+,   trng::mrg3
+,   trng::yarn2
+,   trng::yarn3
+,   trng::yarn4
+,   trng::yarn5
+,   trng::mt19937_64
+)
+{   // distributions with a batch generate(), bitwise as a serial run
+    typedef TestType E;
+    check_generate(trng::normal_dist<double>(1.0, 2.0), 0, E(seed_pi), true);
+    check_generate(trng::lognormal_dist<double>(0.5, 1.5), 0, E(seed_pi), true);
+    check_generate
+    (   trng::truncated_normal_dist<double>(0.0, 1.0, -1.0, 2.0)
+    ,   0
+    ,   E(seed_pi)
+    ,   true
+    );
+    check_generate(trng::fast_normal_dist<double>(1.0, 2.0), 0, E(seed_pi), true);
+}
+
+TEMPLATE_TEST_CASE
+(   "serialize() - engines"
+,   "[serialize]"
+,   pcg32
+,   pcg64
+,   pcg32_k2
+,   p2rng::philox4x32
+,   p2rng::threefry4x64
+,   p2rng::xoshiro256starstar
+,   p2rng::mrg32k3a
+,   trng::lcg64
+,   trng::yarn5
+,   trng::mt19937_64
+)
+{   typedef TestType E;
+    const std::size_t n{100};
+    static_assert(p2rng::serialized_size_v<E> == sizeof(E));
+
+    std::vector<E> ve;
+    for (std::size_t i = 0; i < n; ++i)
+    {   ve.emplace_back(seed_pi);
+        ve.back().discard(i);
+    }
+
+    SECTION("one")
+    {   std::vector<std::byte> buf(p2rng::serialized_size_v<E>);
+        CHECK(p2rng::serialize(ve[7], buf.data()) == buf.data() + buf.size());
+        E g;
+        CHECK(p2rng::deserialize(buf.data(), g) == buf.data() + buf.size());
+        CHECK(g == ve[7]);
+        CHECK(g() == ve[7]());
+    }
+
+    SECTION("array")
+    {   std::vector<std::byte> buf(n * p2rng::serialized_size_v<E>);
+        CHECK(p2rng::serialize(ve.data(), n, buf.data()) == buf.data() + buf.size());
+        std::vector<E> vt(n);
+        auto end = p2rng::deserialize(buf.data(), n, vt.data());
+        CHECK(end == buf.data() + buf.size());
+        CHECK(vt == ve);
+    }
+}
+
+TEST_CASE( "serialize() - distribution parameters", "[serialize][dist]")
+{   auto check = [](auto d)
+    {   typedef typename decltype(d)::param_type P;
+        std::vector<std::byte> buf(p2rng::serialized_size_v<P> + 1);
+        auto end = p2rng::serialize(d.param(), buf.data());
+        CHECK(end == buf.data() + p2rng::serialized_size_v<P>);
+
+        P p;
+        CHECK(p2rng::deserialize(buf.data(), p) == end);
+        CHECK(p == d.param());
+        // the same numbers, tables included
+        auto t = d;
+        t.param(p);
+        pcg32 g1(seed_pi), g2(seed_pi);
+        for (int i = 0; i < 1000; ++i)
+            CHECK(d(g1) == t(g2));
+    };
+
+    SECTION("trivially copyable")
+    {   check(trng::uniform_dist<double>(10, 100));
+        check(trng::normal_dist<float>(5, 2));
+        check(trng::gamma_dist<double>(2, 3));
+        check(trng::uniform_int_dist(10, 100));
+    }
+
+    SECTION("parameters only")
+    {   check(trng::poisson_dist(4.5));
+        check(trng::zero_truncated_poisson_dist(4.5));
+        check(trng::binomial_dist(0.3, 20));
+        check(trng::negative_binomial_dist(0.3, 5));
+        check(trng::hypergeometric_dist(30, 20, 10));
+        CHECK(p2rng::serialized_size_v<trng::poisson_dist::param_type> == 8);
+        CHECK(p2rng::serialized_size_v<trng::binomial_dist::param_type> == 12);
+    }
+
+    // no fixed size
+    static_assert(!p2rng::is_serializable_v<trng::discrete_dist::param_type>);
+    // trivially copyable, but refer to memory they do not own
+    static_assert(!p2rng::is_serializable_v<trng::discrete_dist_view>);
+    static_assert(!p2rng::is_serializable_v<trng::fast_discrete_dist_view<double>>);
+    static_assert(!p2rng::is_serializable_v<trng::fast_discrete_dist_view<float>>);
+    static_assert(!p2rng::is_serializable_v<pcg32_k64::shared_type>);
+    static_assert(!p2rng::is_serializable_v<const double*>);
+    static_assert(p2rng::is_serializable_v<pcg32_k64>);
+}
+
+TEMPLATE_TEST_CASE
+(   "engine_array"
+,   "[engine_array]"
+,   pcg32
+,   pcg32_oneseq
+,   pcg32_fast
+,   pcg64
+,   pcg64_fast
+)
+{   typedef TestType E;
+    typedef p2rng::engine_array<E> A;
+    typedef typename E::state_type S;
+    const std::size_t n{1001};
+    const int steps{10};
+
+    // the engines the array holds
+    std::vector<E> ve;
+    for (std::size_t i = 0; i < n; ++i)
+    {   if constexpr (A::has_streams)
+            ve.emplace_back(seed_pi, S(i));
+        else
+        {   ve.emplace_back(seed_pi);
+            ve.back().advance(S(i) << (E::period_pow2() / 2));
+        }
+    }
+
+    A a(n, seed_pi);
+    REQUIRE(a.size() == n);
+    CHECK(a.get(0) == ve[0]);
+    CHECK(a.get(n - 1) == ve[n - 1]);
+    CHECK(A::has_streams == (nullptr != a.increments()));
+
+    SECTION("step_all()")
+    {   std::vector<typename E::result_type> vt(n);
+        for (int s = 0; s < steps; ++s)
+        {   CHECK(a.step_all(vt.begin()) == vt.end());
+            for (std::size_t i = 0; i < n; ++i)
+                CHECK(vt[i] == ve[i]());
+        }
+        for (std::size_t i = 0; i < n; i += 100)
+            CHECK(E(a[i]) == ve[i]);
+    }
+
+    SECTION("discard_all()")
+    {   a.discard_all(S(123456789));
+        for (auto& e : ve)
+            e.discard(S(123456789));
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK(a.get(i) == ve[i]);
+    }
+
+    SECTION("operator[]")
+    {   CHECK(a[5]() == ve[5]());
+        a[5].discard(S(1000));
+        ve[5].discard(S(1000));
+        CHECK(E(a[5]) == ve[5]);
+
+        a[6] = ve[7];
+        CHECK(a.get(6) == ve[7]);
+        a[8] = a[7];
+        CHECK(a.get(8) == ve[7]);
+        CHECK(a.get(4) == ve[4]);   // untouched neighbours
+        CHECK(a.get(9) == ve[9]);
+    }
+
+    SECTION("executor")
+    {   p2rng::executor ex(p2rng::executor::kind::thread_pool, 3);
+        A b(ex, n, seed_pi);
+        std::vector<typename E::result_type> vt(n), vs(n);
+        b.discard_all(ex, S(99));
+        b.step_all(ex, vt.data());
+        a.discard_all(S(99));
+        a.step_all(vs.data());
+        CHECK(vt == vs);
+    }
+}
+
+TEMPLATE_TEST_CASE
+(   "extended engines - shared table"
+,   "[10K][extended]"
+,   pcg32_k64
+,   pcg32_k64_oneseq
+,   pcg32_k1024_fast
+,   pcg64_k32
+)
+{   typedef TestType E;
+    typedef typename E::result_type R;
+    // some ticks of the table for the engines that tick every 2^16 values
+    const std::size_t n{(1 << 18) + 3};
+
+    std::vector<R> vr(n);
+    std::generate_n(std::begin(vr), n, E(seed_pi));
+    E g(seed_pi);
+    auto table = g.share();
+
+    SECTION("discard()")
+    {   for (std::size_t d : {1, 1000, 65'536, 100'000, 200'001})
+        {   E e(seed_pi);
+            e.discard(d);
+            CHECK(e() == vr[d]);
+            auto s = table.generator();
+            s.discard(d);
+            CHECK(s() == vr[d]);
+        }
+    }
+
+    SECTION("generator()")
+    {   auto s = table.generator();
+        std::vector<R> vt(n);
+        std::generate_n(std::begin(vt), n, std::ref(s));
+        CHECK(vt == vr);
+        CHECK(sizeof(s) < sizeof(E));
+    }
+
+    SECTION("generate_n()")
+    {   p2rng::execution::policy policy;
+        policy.grain = 1;
+        std::vector<R> vt(n);
+        p2rng::generate_n(std::begin(vt), n, table.generator(), policy);
+        CHECK(vt == vr);
+        std::fill(std::begin(vt), std::end(vt), 0);
+        p2rng::generate_n(std::begin(vt), n, g, policy);
+        CHECK(vt == vr);
+    }
+}
+
+TEST_CASE( "extended engines - shared table past the horizon", "[extended]")
+{   // the entries of the largest table start to carry after about 2^18
+    // ticks of 2^16 values
+    const unsigned long long d{1ULL << 38};
+    pcg32_k16384 g(seed_pi);
+    auto table = g.share();
+    CHECK(table.horizon() < (d >> 16));
+
+    auto s = table.generator();
+    g.discard(d);
+    s.discard(d);
+    for (int i = 0; i < 10'000; ++i)
+        CHECK(g() == s());
+}
+
+TEMPLATE_TEST_CASE
+(   "fast_uniform_int_dist"
+,   "[10K][dist]"
+,   std::int32_t
+,   std::int64_t
+,   std::uint64_t
+)
+{   typedef TestType T;
+    typedef trng::fast_uniform_int_dist<T> D;
+    static_assert(D::template draws<pcg64> == 1);
+    static_assert(D::template draws<trng::yarn2> == 1);
+    static_assert(D::template draws<pcg32> == sizeof(T) / 4);
+    static_assert
+    (   p2rng::has_leapfrog_v<p2rng::bind_struct<D, pcg32>> == (sizeof(T) == 4)
+    );
+
+    SECTION("engines")
+    {   // the parallel versions skip whole samples of one or two engine words
+        const bool leapfrog{sizeof(T) == 4};
+        check_generate(D(T(10), T(100)), 0, pcg32(seed_pi), leapfrog);
+        check_generate(D(T(10), T(100)), 0, pcg64(seed_pi), true);
+        check_generate(D(T(10), T(100)), 0, trng::yarn2(seed_pi), true);
+        check_generate(D(T(0), std::numeric_limits<T>::max()), 0, pcg32(seed_pi), leapfrog);
+        check_generate
+        (   D(std::numeric_limits<T>::min() / 2, T(1000))
+        ,   0
+        ,   pcg64(seed_pi)
+        ,   true
+        );
+    }
+
+    SECTION("multiply-high")
+    {   // one draw for each 32-bit word
+        trng::fast_uniform_int_dist<T> d(T(5), T(1005));
+        pcg32 g(seed_pi), r(seed_pi);
+        for (int i = 0; i < 1000; ++i)
+        {   std::uint64_t w = r();
+            if (sizeof(T) == 8)
+                w = (w << 32) | r();
+            std::uint64_t x = sizeof(T) == 8
+            ?   trng::utility::mulhi64(w, 1000)
+            :   (w * 1000) >> 32;
+            CHECK(d(g) == T(5 + x));
+        }
+        CHECK(trng::utility::mulhi64(~0ULL, ~0ULL) == ~0ULL - 1);
+        CHECK(trng::utility::mulhi64(1ULL << 63, 6) == 3);
+    }
+
+    SECTION("uniformity")
+    {   trng::fast_uniform_int_dist<T> d(T(0), T(10));
+        std::vector<std::size_t> counts(10);
+        pcg32 g(seed_pi);
+        const std::size_t m{100'000};
+        for (std::size_t i = 0; i < m; ++i)
+            ++counts[std::size_t(d(g))];
+        for (auto c : counts)
+            CHECK(std::abs(double(c) - m / 10.0) < 0.05 * m / 10.0);
+    }
+}
+
+TEST_CASE( "discrete_dist - view and batched updates", "[10K][dist]")
+{   const std::size_t n{10'007};
+    p2rng::execution::policy policy;
+    policy.grain = 1;
+    std::vector<double> w(1001);
+    for (std::size_t i = 0; i < w.size(); ++i)
+        w[i] = 1.0 + double(i % 17);
+    trng::discrete_dist d(std::begin(w), std::end(w));
+
+    SECTION("view")
+    {   auto v = d.view();
+        static_assert(std::is_trivially_copyable_v<decltype(v)>);
+        CHECK(v.min() == d.min());
+        CHECK(v.max() == d.max());
+        CHECK(v.pdf(16) == d.pdf(16));
+
+        std::vector<int> vr(n), vt(n), vp(n);
+        std::generate_n(std::begin(vr), n, std::bind(d, pcg32(seed_pi)));
+        std::generate_n(std::begin(vt), n, std::bind(v, pcg32(seed_pi)));
+        CHECK(vt == vr);
+        p2rng::generate_n(std::begin(vp), n, p2rng::bind(v, pcg32(seed_pi)), policy);
+        CHECK(vp == vr);
+
+        // the view sees later changes of the weights
+        d.param(0, 1e9);
+        pcg32 g(seed_pi);
+        CHECK(v(g) == 0);
+    }
+
+    SECTION("param()")
+    {   // a few weights, one at a time and in one batch, as if built anew
+        std::vector<int> x{3, 500, 1000, 77, 500};
+        std::vector<double> p{0.5, 7.0, 2.5, 0.0, 9.0};
+        auto e = d;
+        for (std::size_t i = 0; i < x.size(); ++i)
+        {   d.param(x[i], p[i]);
+            w[std::size_t(x[i])] = p[i];
+        }
+        e.param(std::begin(x), std::end(x), std::begin(p));
+        trng::discrete_dist f(std::begin(w), std::end(w));
+        CHECK(d.param() == f.param());
+        CHECK(e.param() == f.param());
+
+        // so many that the tree is rebuilt
+        std::vector<int> y(800);
+        std::vector<double> q(800);
+        for (std::size_t i = 0; i < y.size(); ++i)
+        {   y[i] = int(i);
+            q[i] = w[i] = 2.0;
+        }
+        e.param(std::begin(y), std::end(y), std::begin(q));
+        trng::discrete_dist h(std::begin(w), std::end(w));
+        CHECK(e.param() == h.param());
+    }
+}
+
+TEST_CASE( "fast_discrete_dist - packed shared alias table", "[10K][dist]")
+{   const std::size_t n{10'007};
+    p2rng::execution::policy policy;
+    policy.grain = 1;
+
+    SECTION("fast_discrete_dist")
+    {   std::vector<double> w(1001);
+        for (std::size_t i = 0; i < w.size(); ++i)
+            w[i] = 1.0 + double(i % 17);
+        trng::fast_discrete_dist d(std::begin(w), std::end(w));
+        auto v = d.view();
+        static_assert(std::is_trivially_copyable_v<decltype(v)>);
+        CHECK(v.max() == d.max());
+
+        // copies share the table
+        auto e = d;
+        CHECK(e.view().data() == v.data());
+        CHECK(e == d);
+
+        std::vector<int> vr(n), vt(n), vp(n);
+        std::generate_n(std::begin(vr), n, std::bind(d, pcg32(seed_pi)));
+        std::generate_n(std::begin(vt), n, std::bind(v, pcg32(seed_pi)));
+        CHECK(vt == vr);
+        p2rng::generate_n(std::begin(vp), n, p2rng::bind(v, pcg32(seed_pi)), policy);
+        CHECK(vp == vr);
+    }
+
+    SECTION("alias_table")
+    {   using table = trng::alias_table<float>;
+        static_assert(sizeof(table::entry_type) == 8);
+
+        // several blocks, the same parallel table for any number of threads
+        std::vector<double> w(3 * table::block_size + 123);
+        for (std::size_t i = 0; i < w.size(); ++i)
+            w[i] = double((i * 7919) % 1009) * (i < table::block_size ? 3.0 : 1.0);
+        p2rng::executor ex1(p2rng::executor::kind::openmp, 1);
+        table t(ex1, std::begin(w), std::end(w));
+        for (std::size_t threads : {3, 4})
+        {   p2rng::executor ex(p2rng::executor::kind::openmp, threads);
+            table u(ex, std::begin(w), std::end(w));
+            REQUIRE(u.size() == t.size());
+            CHECK(0 == std::memcmp(u.data(), t.data(), t.size() * 8));
+        }
+        // and the serial one for up to a block of weights
+        {   table u(std::begin(w), std::begin(w) + table::block_size);
+            table v(ex1, std::begin(w), std::begin(w) + table::block_size);
+            CHECK(0 == std::memcmp(u.data(), v.data(), u.size() * 8));
+        }
+
+        // the probabilities of both tables are those of the weights
+        const double s = std::accumulate(std::begin(w), std::end(w), 0.0);
+        for (const auto& u : {t, table(std::begin(w), std::end(w))})
+        {   std::vector<double> p(w.size());
+            for (std::size_t i = 0; i < u.size(); ++i)
+            {   p[i] += u[i].threshold;
+                if (u[i].alias != i)
+                    p[u[i].alias] += 1.0 - u[i].threshold;
+            }
+            for (std::size_t i = 0; i < u.size(); ++i)
+                CHECK(p[i] / double(u.size()) == Approx(w[i] / s).margin(1e-12));
+        }
+    }
+
+    SECTION("same sequences as TRNG")
+    {   // TRNG's table, built in a single pass over all weights
+        std::vector<double> w(3 * trng::alias_table<double>::block_size + 123);
+        for (std::size_t i = 0; i < w.size(); ++i)
+            w[i] = double((i * 7919) % 1009) + 0.5;
+        const std::size_t N = w.size();
+        std::vector<double> P(w), F(N);
+        std::vector<int> L(N, 0), S, G;
+        const double s = std::accumulate(std::begin(P), std::end(P), 0.0);
+        for (auto& x : P)
+            x /= s;
+        for (std::size_t i = 0; i < N; ++i)
+        {   F[i] = N * P[i];
+            (F[i] < 1.0 ? S : G).push_back(int(i));
+        }
+        while (!S.empty() && !G.empty())
+        {   const int k = G.back(), j = S.back();
+            L[j] = k;
+            F[k] -= 1.0 - F[j];
+            S.pop_back();
+            if (F[k] < 1.0)
+            {   G.pop_back();
+                S.push_back(k);
+            }
+        }
+        auto icdf = [&](double u)
+        {   const double U = u * N;
+            const int I = int(U);
+            return U - I <= F[I] ? I : L[I];
+        };
+
+        trng::fast_discrete_dist d(std::begin(w), std::end(w));
+        pcg32 g(seed_pi), h(seed_pi);
+        for (std::size_t i = 0; i < n; ++i)
+            CHECK(d(g) == icdf(trng::utility::uniformco<double>(h)));
+    }
+}
+
+TEST_CASE( "utility::discrete() - guide table", "[10K][dist]")
+{   std::vector<std::vector<double>> cdfs
+    {   {1.0}
+    ,   {0.25, 1.0}
+    ,   {0.0, 0.0, 0.5, 0.5, 0.5, 1.0}
+    ,   {0.125, 0.125, 0.375, 0.75, 1.0, 1.0, 1.0}
+    };
+    // a binomial distribution, n = 1000, with its long tails
+    trng::binomial_dist b(0.3, 1000);
+    std::vector<double> c(1001);
+    for (int i = 0; i < 1001; ++i)
+        c[std::size_t(i)] = b.cdf(i);
+    cdfs.push_back(c);
+
+    pcg32 g(seed_pi);
+    for (const auto& P : cdfs)
+    {   auto guide = trng::utility::discrete_guide(std::begin(P), std::end(P));
+        REQUIRE(guide.size() >= P.size());
+        std::vector<double> xs;
+        for (auto p : P)
+            xs.insert(xs.end(), {p, std::nextafter(p, 0.0), std::nextafter(p, 1.0)});
+        for (std::size_t k = 0; k < guide.size(); ++k)
+        {   double x = double(k) / double(guide.size());
+            xs.insert(xs.end(), {x, std::nextafter(x, 0.0), std::nextafter(x, 1.0)});
+        }
+        for (int i = 0; i < 10'007; ++i)
+            xs.push_back(trng::utility::uniformoo<double>(g));
+        for (auto x : xs)
+            if (x > 0.0 && x < 1.0)
+                CHECK
+                (   trng::utility::discrete(x, std::begin(P), std::end(P), guide)
+                ==  trng::utility::discrete(x, std::begin(P), std::end(P))
+                );
+    }
+}
+
+TEST_CASE( "poisson_dist, binomial_dist - CDF window", "[10K][dist]")
+{   const std::size_t n{10'007};
+
+    SECTION("large parameters")
+    {   // whole CDF below mu = 2048 or cdf_window::full_size values, window from there on
+        for (double mu : {1e6, 1e9, 2047.5, 2048.0})
+        {   auto v = check_generate(trng::poisson_dist(mu), 0, pcg32(seed_pi), true);
+            double m = std::accumulate(std::begin(v), std::end(v), 0.0) / n;
+            CHECK(std::abs(m - mu) < 5 * std::sqrt(mu / n));
+        }
+        const std::pair<double, int> binomials[]
+        {   {0.3, 100'000'000}, {1e-6, 1'000'000'000}, {0.3, 131'071}, {0.3, 131'072}   };
+        for (auto [p, k] : binomials)
+        {   auto v = check_generate(trng::binomial_dist(p, k), 0, pcg32(seed_pi), true);
+            double m = std::accumulate(std::begin(v), std::end(v), 0.0) / n;
+            CHECK(std::abs(m - k * p) < 5 * std::sqrt(k * p * (1 - p) / n));
+        }
+
+        trng::binomial_dist b(0.3, 100'000'000);
+        CHECK(b.pdf(30'000'000) == Approx(1 / std::sqrt(2 * M_PI * 2.1e7)).epsilon(1e-6));
+        CHECK(b.cdf(30'000'000) == Approx(0.5).epsilon(1e-3));
+        CHECK(b.cdf(-1) == 0);
+        CHECK(b.cdf(100'000'000) == 1);
+    }
+
+    SECTION("against the whole table")
+    {   // the window inverts the same uniforms to the same values as the whole CDF, but for
+        // those within rounding of a step of it
+        auto check_window = [n](auto d, const std::vector<double>& P)
+        {   pcg32 g(seed_pi), h(seed_pi);
+            std::size_t differ{0};
+            for (std::size_t i = 0; i < n; ++i)
+            {   const double u = trng::utility::uniformoo<double>(h);
+                const int x = d(g);
+                const int y = int(trng::utility::discrete(u, std::begin(P), std::end(P)));
+                if (x != y)
+                {   ++differ;
+                    CHECK(std::abs(x - y) == 1);
+                    CHECK(std::abs(u - P[std::min(x, y)]) < 1e-12);
+                }
+            }
+            CHECK(differ < n / 1000);
+        };
+
+        const double p{0.3};
+        const int k{200'000};
+        std::vector<double> P;
+        double ln_binom{0};
+        for (int i = 0; i <= k; ++i)
+        {   P.push_back(std::exp(ln_binom + i * std::log(p) + (k - i) * std::log(1 - p)));
+            ln_binom += std::log(double(k - i)) - std::log(double(i + 1));
+        }
+        std::partial_sum(std::begin(P), std::end(P), std::begin(P));
+        for (auto& x : P)
+            x /= P.back();
+        check_window(trng::binomial_dist(p, k), P);
+
+        // TRNG's poisson table loses accuracy at large mu, it is summed up exactly here
+        const double mu{200'000};
+        P.clear();
+        long double sum{0};
+        for (int i = 0; i < 2 * mu; ++i)
+        {   sum += std::exp(i * std::log((long double)mu) - mu - std::lgamma(i + 1.0L));
+            P.push_back(double(sum));
+        }
+        P.push_back(1);
+        check_window(trng::poisson_dist(mu), P);
+    }
+
+    SECTION("tails")
+    {   // the tail below the window of mu = 100, against the incomplete gamma function
+        const double mu{100};
+        trng::poisson_dist d(mu);
+        auto up = [mu](int x) { return mu / (x + 1.0); };
+        auto down = [mu](int x) { return x / mu; };
+        trng::utility::cdf_window w(100, std::numeric_limits<int>::max(), up, down);
+        REQUIRE(w.lo() > 0);
+        CHECK(d.cdf(w.lo() - 1) < trng::utility::cdf_window::tail);
+        CHECK(1 - d.cdf(w.hi()) < trng::utility::cdf_window::tail);
+
+        for (int x : {0, 1, w.lo() / 2, w.lo() - 1, w.lo(), w.hi(), w.hi() + 20})
+        {   CHECK(w.pdf(x, up, down) == Approx(d.pdf(x)).epsilon(1e-9));
+            CHECK(w.cdf(x, up, down) == Approx(d.cdf(x)).epsilon(1e-9));
+        }
+        for (double u : {1e-300, 1e-100, 1e-50, 1e-30, 1e-20, 1e-18})
+        {   int x = w.icdf(u, up, down);
+            CHECK(x < w.lo());
+            CHECK(d.cdf(x - 1) < u * (1 + 1e-9));
+            CHECK(u <= d.cdf(x) * (1 + 1e-9));
+        }
+        // binomial distributions with small n tabulate all values
+        trng::binomial_dist b(0.3, 20);
+        CHECK(b.cdf(20) == 1);
+        CHECK(b.pdf(0) == Approx(std::pow(0.7, 20)).epsilon(1e-12));
+    }
+}
+
+template <class Distribution>
+void check_tabulated_icdf(Distribution d, double max_fallback)
+{   typedef typename Distribution::result_type T;
+    const std::size_t n{10'007};
+    p2rng::tabulated_icdf<Distribution> t(d);
+    CHECK(t.fallback_probability() < max_fallback);
+
+    // within the tolerance, exact far out in the tails
+    const double s = std::abs(double(d.icdf(T(0.75))) - double(d.icdf(T(0.25))));
+    pcg32 g(seed_pi);
+    std::vector<T> u(n);
+    for (auto& x : u)
+        x = trng::utility::uniformoo<T>(g);
+    u.insert(u.end(), {T(1e-30), T(1e-6), T(0.5), T(1) - T(1e-6)});
+    for (auto x : u)
+    {   const double y = double(d.icdf(x));
+        CHECK
+        (   (   std::abs(double(t.icdf(x)) - y) <= t.tolerance() * (std::abs(y) + s)
+            ||  t.icdf(x) == d.icdf(x)
+            )
+        );
+    }
+    CHECK(t.icdf(T(1e-30)) == d.icdf(T(1e-30)));
+
+    // one uniform per sample
+    check_generate(t, 0, pcg32(seed_pi), true);
+    pcg32 g1(seed_pi), g2(seed_pi);
+    for (std::size_t i = 0; i < n; ++i)
+    {   t(g1);
+        trng::utility::uniformoo<T>(g2);
+    }
+    CHECK(g1 == g2);
+}
+
+TEST_CASE( "tabulated_icdf", "[10K][dist]")
+{   check_tabulated_icdf(trng::beta_dist<double>(2, 5), 1e-5);
+    check_tabulated_icdf(trng::beta_dist<double>(0.5, 0.5), 1e-5);
+    check_tabulated_icdf(trng::gamma_dist<double>(2, 3), 1e-4);
+    check_tabulated_icdf(trng::student_t_dist<double>(3), 1e-4);
+    check_tabulated_icdf(trng::chi_square_dist<double>(4), 1e-4);
+    check_tabulated_icdf(trng::snedecor_f_dist<double>(3, 7), 1e-4);
+    check_tabulated_icdf(trng::maxwell_dist<double>(1), 1e-4);
+    check_tabulated_icdf(trng::gamma_dist<float>(2, 3), 2e-3);
+
+    // gamma_dist::icdf() is NaN or infinite for small u if kappa < 1, the
+    // table calls it there, and rejects distributions with a NaN quartile
+    trng::gamma_dist<double> d(0.5, 1);
+    p2rng::tabulated_icdf<trng::gamma_dist<double>> t(d);
+    CHECK(t.fallback_probability() < 0.25);
+    const double s = d.icdf(0.75) - d.icdf(0.25);
+    pcg32 g(seed_pi);
+    for (int i = 0; i < 10'007; ++i)
+    {   const double u = trng::utility::uniformoo<double>(g), y = d.icdf(u);
+        if (std::isfinite(y))
+            CHECK(std::abs(t.icdf(u) - y) <= t.tolerance() * (y + s));
+        else
+            CHECK((t.icdf(u) == y || (std::isnan(t.icdf(u)) && std::isnan(y))));
+    }
+    CHECK_THROWS_AS
+    (   p2rng::tabulated_icdf<trng::gamma_dist<double>>(trng::gamma_dist<double>(0.3, 1))
+    ,   std::invalid_argument
+    );
+}